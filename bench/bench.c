@@ -0,0 +1,261 @@
+/**
+ * @file    bench.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Benchmark harness source file. Runs every registered benchmark and
+ *          prints the results as CSV on `stdout`.
+ *
+ * Usage: bench [-q] [-n max size] [-f filter] [-t threads]
+ *   -q  do not print the CSV header
+ *   -n  the largest list size to run (default 10000000)
+ *   -f  only run benchmarks whose name contains the filter
+ *   -t  the number of threads for multi-threaded benchmarks (default is the
+ *       number of online processors)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "bench.h"
+#include "../linkedlist.h"
+
+
+#ifndef BENCH_VERSION
+    #define BENCH_VERSION "unknown"
+#endif
+
+/* The upper bound on nodes visited by linear operations in a single run */
+#define LINEAR_WORK 10000000UL
+/* The smallest and default largest list sizes */
+#define MIN_SIZE 1000UL
+#define MAX_SIZE 10000000UL
+
+
+/* Every suite of benchmarks to run */
+static const Benchmark *suites[] = {
+    listBenchmarks,
+    concurrentBenchmarks
+};
+
+
+static struct timespec started;
+static double elapsed;
+static unsigned int threads;
+
+
+void benchStart(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &started);
+}
+
+
+void benchStop(void)
+{
+    struct timespec stopped;
+    clock_gettime(CLOCK_MONOTONIC, &stopped);
+
+    elapsed += (stopped.tv_sec - started.tv_sec) * 1e9 +
+        (stopped.tv_nsec - started.tv_nsec);
+}
+
+
+unsigned long linearOps(unsigned long size)
+{
+    unsigned long ops = LINEAR_WORK / size;
+
+    if (ops > size)
+        ops = size;
+
+    return ops ? ops : 1;
+}
+
+
+unsigned int benchThreads(void)
+{
+    return threads;
+}
+
+
+int *benchValue(int value)
+{
+    int *data = malloc(sizeof(int));
+    if (!data)
+    {
+        fprintf(stderr, "bench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    *data = value;
+    return data;
+}
+
+
+/**
+ * Describe the conditional compilation switches the library was built with.
+ */
+static const char *configuration(void)
+{
+    static const char *switches = ""
+#ifdef DOUBLE_ENDED
+        "+DOUBLE_ENDED"
+#endif
+#ifdef DOUBLY_LINKED
+        "+DOUBLY_LINKED"
+#endif
+#ifdef INSTANT_LENGTH
+        "+INSTANT_LENGTH"
+#endif
+        ;
+
+    /* skip the leading separator */
+    return *switches ? switches + 1 : "default";
+}
+
+
+/**
+ * Fragment the heap so that nodes allocated afterwards are scattered. Blocks
+ * the size of a node and of an element are allocated then freed in a random
+ * order, and the allocator hands them back out in that order.
+ */
+static void scatterHeap(unsigned long size)
+{
+    unsigned long count = 2 * size;
+    unsigned long i;
+    unsigned long seed = 88172645463325252UL;
+    void **blocks = malloc(count * sizeof(void *));
+
+    if (!blocks)
+        return;
+
+    for (i = 0; i < count; i++)
+        blocks[i] = malloc(i % 2 ? sizeof(ListNode) : sizeof(int));
+
+    /* Fisher-Yates shuffle with a xorshift generator */
+    for (i = count - 1; i > 0; i--)
+    {
+        unsigned long j;
+        void *swap;
+
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        j = seed % (i + 1);
+
+        swap = blocks[i];
+        blocks[i] = blocks[j];
+        blocks[j] = swap;
+    }
+
+    for (i = 0; i < count; i++)
+        free(blocks[i]);
+    free(blocks);
+}
+
+
+/**
+ * Run a single benchmark in a child process and print its result.
+ */
+static void runBenchmark(const Benchmark *benchmark, unsigned long size,
+        BenchPattern pattern)
+{
+    const char *patternName = pattern == PATTERN_SCATTERED ? "scattered" : "sequential";
+    int status;
+    pid_t child;
+
+    fflush(stdout);
+    child = fork();
+
+    if (child == 0)
+    {
+        struct rusage setup, usage;
+        unsigned long ops;
+
+        if (pattern == PATTERN_SCATTERED)
+            scatterHeap(size);
+
+        /* the benchmark reuses the scattered blocks, so the peak covers them
+         * too and the peak at the end of the setup is reported beside it */
+        getrusage(RUSAGE_SELF, &setup);
+        elapsed = 0;
+        ops = benchmark->run(size, pattern);
+        getrusage(RUSAGE_SELF, &usage);
+
+        printf("%s,%s,%s,%s,%lu,%lu,%.3f,%.0f,%ld,%ld\n", BENCH_VERSION,
+                configuration(), benchmark->name, patternName, size, ops,
+                elapsed / ops, ops / (elapsed / 1e9), usage.ru_maxrss,
+                setup.ru_maxrss);
+        fflush(stdout);
+        _exit(EXIT_SUCCESS);
+    }
+
+    if (child < 0 || waitpid(child, &status, 0) < 0 || !WIFEXITED(status) ||
+            WEXITSTATUS(status) != EXIT_SUCCESS)
+        fprintf(stderr, "bench: %s (%s, %lu) failed\n", benchmark->name,
+                patternName, size);
+}
+
+
+int main(int argc, char **argv)
+{
+    unsigned long maxSize = MAX_SIZE;
+    const char *filter = NULL;
+    int header = TRUE;
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned long size;
+    size_t suite;
+    int option;
+
+    threads = processors > 0 ? (unsigned int) processors : 1;
+
+    while ((option = getopt(argc, argv, "qn:f:t:")) != -1)
+    {
+        switch (option)
+        {
+            case 'q':
+                header = FALSE;
+                break;
+            case 'n':
+                maxSize = strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                filter = optarg;
+                break;
+            case 't':
+                threads = (unsigned int) strtoul(optarg, NULL, 10);
+                if (!threads)
+                    threads = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-q] [-n max size] [-f filter] [-t threads]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (header)
+        printf("version,switches,benchmark,pattern,size,ops,ns_per_op,ops_per_sec,peak_rss_kb,setup_rss_kb\n");
+
+    for (suite = 0; suite < sizeof(suites) / sizeof(suites[0]); suite++)
+    {
+        const Benchmark *benchmark;
+
+        for (benchmark = suites[suite]; benchmark->name; benchmark++)
+        {
+            if (filter && !strstr(benchmark->name, filter))
+                continue;
+
+            for (size = MIN_SIZE; size <= maxSize; size *= 10)
+            {
+                runBenchmark(benchmark, size, PATTERN_SEQUENTIAL);
+                runBenchmark(benchmark, size, PATTERN_SCATTERED);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
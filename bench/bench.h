@@ -0,0 +1,99 @@
+/**
+ * @file    bench.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Benchmark harness for the linked list library. Each benchmark is
+ *          run in its own process for every size and access pattern, and one
+ *          CSV line is printed per run.
+ */
+
+
+#ifndef BENCH_H
+#define BENCH_H
+
+
+/**
+ * The ways a benchmark can lay out its list in memory.
+ */
+typedef enum BenchPattern {
+    /* nodes are allocated from a fresh heap, so are mostly adjacent */
+    PATTERN_SEQUENTIAL,
+    /* the heap is shuffled beforehand, so nodes end up scattered */
+    PATTERN_SCATTERED
+} BenchPattern;
+
+
+/**
+ * @brief A function type that runs a single benchmark.
+ *
+ * The function should perform any setup, then wrap the measured work in calls
+ * to benchStart() and benchStop().
+ *
+ * @param size The number of elements to benchmark with.
+ * @param pattern The memory layout to use.
+ * @return The number of operations performed between benchStart() and
+ *         benchStop().
+ */
+typedef unsigned long (* BenchFunc)(unsigned long size, BenchPattern pattern);
+
+
+/**
+ * A `struct` describing a single benchmark.
+ */
+typedef struct Benchmark {
+    const char *name;
+    BenchFunc run;
+} Benchmark;
+
+
+/**
+ * The benchmarks from each suite. Each array is terminated by an entry with a
+ * `NULL` name.
+ */
+extern const Benchmark listBenchmarks[];
+extern const Benchmark concurrentBenchmarks[];
+
+
+/**
+ * @brief Start timing the measured part of a benchmark.
+ */
+void benchStart(void);
+
+
+/**
+ * @brief Stop timing the measured part of a benchmark.
+ */
+void benchStop(void);
+
+
+/**
+ * @brief Calculate how many operations to measure for an operation that
+ *        traverses the list on each call.
+ *
+ * Keeps the total amount of work for linear operations bounded so large sizes
+ * finish in a reasonable time.
+ *
+ * @param size The length of the list the operation works on.
+ * @return The number of operations to perform, at least one.
+ */
+unsigned long linearOps(unsigned long size);
+
+
+/**
+ * @brief Get the number of threads multi-threaded benchmarks should use.
+ *
+ * @return The number given with `-t`, or the number of online processors.
+ */
+unsigned int benchThreads(void);
+
+
+/**
+ * @brief Allocate an integer to store in a list.
+ *
+ * @param value The value to store.
+ * @return A pointer to a new integer, aborting the benchmark on failure.
+ */
+int *benchValue(int value);
+
+
+#endif /* end of include guard: BENCH_H */
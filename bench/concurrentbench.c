@@ -0,0 +1,176 @@
+/**
+ * @file    concurrentbench.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Multi-threaded benchmarks comparing the lock-free containers with a
+ *          `LinkedList` guarded by a mutex. Each operation counted is one
+ *          insertion followed by one removal.
+ */
+
+#include <pthread.h>
+#include "bench.h"
+#include "../linkedlist.h"
+#include "../concurrentstack.h"
+#include "../concurrentqueue.h"
+
+
+/**
+ * A `struct` holding the arguments shared by every worker thread.
+ */
+typedef struct Workload {
+    void *container;
+    pthread_mutex_t lock;
+    unsigned long ops;
+} Workload;
+
+
+/* Data stored by the benchmarks; never freed as each run empties its list */
+static int element;
+
+
+/**
+ * Run @p worker on the configured number of threads, splitting @p size
+ * operations between them, and time the whole run.
+ */
+static unsigned long runThreads(void *(* worker)(void *), void *container,
+        unsigned long size)
+{
+    unsigned int count = benchThreads();
+    pthread_t *threads = malloc(count * sizeof(pthread_t));
+    Workload workload;
+    unsigned int i;
+
+    workload.container = container;
+    workload.ops = size / count;
+    pthread_mutex_init(&workload.lock, NULL);
+
+    benchStart();
+    for (i = 0; i < count; i++)
+        pthread_create(&threads[i], NULL, worker, &workload);
+    for (i = 0; i < count; i++)
+        pthread_join(threads[i], NULL);
+    benchStop();
+
+    pthread_mutex_destroy(&workload.lock);
+    free(threads);
+    return workload.ops * count;
+}
+
+
+static void *stackWorker(void *argument)
+{
+    Workload *workload = argument;
+    unsigned long i;
+
+    for (i = 0; i < workload->ops; i++)
+    {
+        insertConcurrentTop(workload->container, &element);
+        popConcurrentTop(workload->container);
+    }
+
+    return NULL;
+}
+
+
+static void *mutexStackWorker(void *argument)
+{
+    Workload *workload = argument;
+    unsigned long i;
+
+    for (i = 0; i < workload->ops; i++)
+    {
+        pthread_mutex_lock(&workload->lock);
+        insertTop(workload->container, &element);
+        pthread_mutex_unlock(&workload->lock);
+
+        pthread_mutex_lock(&workload->lock);
+        popTop(workload->container);
+        pthread_mutex_unlock(&workload->lock);
+    }
+
+    return NULL;
+}
+
+
+static void *queueWorker(void *argument)
+{
+    Workload *workload = argument;
+    unsigned long i;
+
+    for (i = 0; i < workload->ops; i++)
+    {
+        enqueue(workload->container, &element);
+        dequeue(workload->container);
+    }
+
+    return NULL;
+}
+
+
+static void *mutexQueueWorker(void *argument)
+{
+    Workload *workload = argument;
+    unsigned long i;
+
+    for (i = 0; i < workload->ops; i++)
+    {
+        pthread_mutex_lock(&workload->lock);
+        insertTail(workload->container, &element);
+        pthread_mutex_unlock(&workload->lock);
+
+        pthread_mutex_lock(&workload->lock);
+        popTop(workload->container);
+        pthread_mutex_unlock(&workload->lock);
+    }
+
+    return NULL;
+}
+
+
+static unsigned long benchConcurrentStack(unsigned long size, BenchPattern pattern)
+{
+    ConcurrentStack *stack = createConcurrentStack(benchThreads());
+    unsigned long ops = runThreads(&stackWorker, stack, size);
+
+    destroyConcurrentStack(stack);
+    return ops;
+}
+
+
+static unsigned long benchMutexStack(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = createList();
+    unsigned long ops = runThreads(&mutexStackWorker, list, size);
+
+    destroyList(list);
+    return ops;
+}
+
+
+static unsigned long benchConcurrentQueue(unsigned long size, BenchPattern pattern)
+{
+    ConcurrentQueue *queue = createConcurrentQueue();
+    unsigned long ops = runThreads(&queueWorker, queue, size);
+
+    destroyConcurrentQueue(queue);
+    return ops;
+}
+
+
+static unsigned long benchMutexQueue(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = createList();
+    unsigned long ops = runThreads(&mutexQueueWorker, list, size);
+
+    destroyList(list);
+    return ops;
+}
+
+
+const Benchmark concurrentBenchmarks[] = {
+    { "concurrentStack", &benchConcurrentStack },
+    { "mutexStack", &benchMutexStack },
+    { "concurrentQueue", &benchConcurrentQueue },
+    { "mutexQueue", &benchMutexQueue },
+    { NULL, NULL }
+};
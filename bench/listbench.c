@@ -0,0 +1,1188 @@
+/**
+ * @file    listbench.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Benchmarks for the core linked list operations. Operations that
+ *          traverse the list on every call in the current configuration are
+ *          measured over fewer calls (see linearOps()).
+ */
+
+#include "bench.h"
+#include "../linkedlist.h"
+#include "../unrolledlist.h"
+#include "../parallelreduce.h"
+#include "../frozenlist.h"
+#include "../skiplist.h"
+#include "../xorlist.h"
+#include "../compactlist.h"
+#include "../typedlist.h"
+#include "../pipeline.h"
+#include "../keyedlist.h"
+
+
+/* Whether the tail and length operations are constant time in this build */
+#ifdef DOUBLE_ENDED
+    #define TAIL_INSERT_OPS(size) (size)
+    #ifdef DOUBLY_LINKED
+        #define TAIL_REMOVE_OPS(size) (size)
+    #endif
+#endif
+#ifndef TAIL_INSERT_OPS
+    #define TAIL_INSERT_OPS(size) linearOps(size)
+#endif
+#ifndef TAIL_REMOVE_OPS
+    #define TAIL_REMOVE_OPS(size) linearOps(size)
+#endif
+#ifdef INSTANT_LENGTH
+    #define LENGTH_OPS(size) (size)
+#else
+    #define LENGTH_OPS(size) linearOps(size)
+#endif
+
+
+/**
+ * Build a list of @p size elements in order using insertTop().
+ */
+static LinkedList *buildList(unsigned long size)
+{
+    LinkedList *list = createList();
+    unsigned long i;
+
+    for (i = size; i > 0; i--)
+        insertTop(list, benchValue(i - 1));
+
+    return list;
+}
+
+
+static void *sumReducer(DataPointer data, void *carry)
+{
+    *(long *) carry += *(int *) data;
+    return carry;
+}
+
+
+static unsigned long benchInsertTop(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = createList();
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < size; i++)
+        insertTop(list, benchValue(i));
+    benchStop();
+
+    destroyList(list);
+    return size;
+}
+
+
+static unsigned long benchInsertTail(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = TAIL_INSERT_OPS(size);
+    LinkedList *list = buildList(size - ops);
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < ops; i++)
+        insertTail(list, benchValue(i));
+    benchStop();
+
+    destroyList(list);
+    return ops;
+}
+
+
+static unsigned long benchInsertArrayTail(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = createList();
+    DataPointer *items = malloc(size * sizeof(DataPointer));
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+        items[i] = benchValue(i);
+
+    /* the whole batch is one allocation and one splice */
+    benchStart();
+    insertArrayTail(list, items, size);
+    benchStop();
+
+    destroyList(list);
+    free(items);
+    return size;
+}
+
+static unsigned long benchRemoveTop(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < size; i++)
+        removeTop(list);
+    benchStop();
+
+    destroyList(list);
+    return size;
+}
+
+
+static unsigned long benchRemoveTail(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = TAIL_REMOVE_OPS(size);
+    LinkedList *list = buildList(size);
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < ops; i++)
+        removeTail(list);
+    benchStop();
+
+    destroyList(list);
+    return ops;
+}
+
+
+static unsigned long benchPeekTail(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = TAIL_INSERT_OPS(size);
+    LinkedList *list = buildList(size);
+    long sum = 0;
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < ops; i++)
+        sum += *(int *) peekTail(list);
+    benchStop();
+
+    destroyList(list);
+    return sum >= 0 ? ops : 0;
+}
+
+
+static unsigned long benchPeekIndex(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    long sum = 0;
+    unsigned long i;
+
+    /* sequential indexes continue from the finger */
+    benchStart();
+    for (i = 0; i < size; i++)
+        sum += *(int *) peekIndex(list, (long) i);
+    benchStop();
+
+    destroyList(list);
+    return sum >= 0 ? size : 0;
+}
+
+
+static unsigned long benchPeekNegativeIndex(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    long sum = 0;
+    unsigned long i;
+
+    /* the length is only counted for the first index */
+    benchStart();
+    for (i = size; i > 0; i--)
+        sum += *(int *) peekIndex(list, -(long) i);
+    benchStop();
+
+    destroyList(list);
+    return sum >= 0 ? size : 0;
+}
+
+
+static unsigned long benchInsertIndex(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size / 2);
+    unsigned long ops = size - size / 2;
+    unsigned long i;
+
+    /* insert after every element of the existing list in one sweep */
+    benchStart();
+    for (i = 0; i < ops; i++)
+        insertIndex(list, benchValue(i), (long) (2 * i + 1));
+    benchStop();
+
+    destroyList(list);
+    return ops;
+}
+
+
+static unsigned long benchListLength(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = LENGTH_OPS(size);
+    LinkedList *list = buildList(size);
+    unsigned long total = 0;
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < ops; i++)
+        total += listLength(list);
+    benchStop();
+
+    destroyList(list);
+    return total == ops * size ? ops : 0;
+}
+
+
+static unsigned long benchReduceList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    long sum = 0;
+
+    /* each element visited counts as one operation */
+    benchStart();
+    reduceList(list, &sumReducer, &sum);
+    benchStop();
+
+    destroyList(list);
+    return sum >= 0 ? size : 0;
+}
+
+
+static void *countReducer(DataPointer data, void *carry)
+{
+    (void) data;
+    (*(unsigned long *) carry)++;
+    return carry;
+}
+
+
+static unsigned long benchScanList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    unsigned long count = 0;
+
+    /* only the nodes are visited, not the data they point to */
+    benchStart();
+    reduceList(list, &countReducer, &count);
+    benchStop();
+
+    destroyList(list);
+    return count == size ? size : 0;
+}
+
+
+static unsigned long benchScanCompactedList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    unsigned long count = 0;
+
+    compactList(list);
+
+    benchStart();
+    reduceList(list, &countReducer, &count);
+    benchStop();
+
+    destroyList(list);
+    return count == size ? size : 0;
+}
+
+
+static unsigned long benchCompactList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    int compacted;
+
+    benchStart();
+    compacted = compactList(list);
+    benchStop();
+
+    destroyList(list);
+    return compacted ? size : 0;
+}
+
+
+static void *sumIdentity(void)
+{
+    long *sum = malloc(sizeof(long));
+    *sum = 0;
+    return sum;
+}
+
+
+static void *sumCombiner(void *left, void *right)
+{
+    *(long *) left += *(long *) right;
+    free(right);
+    return left;
+}
+
+
+static unsigned long benchReduceListParallel(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    long *sum;
+
+    benchStart();
+    sum = reduceListParallel(list, &sumReducer, &sumCombiner, &sumIdentity,
+            benchThreads());
+    benchStop();
+
+    destroyList(list);
+    free(sum);
+    return size;
+}
+
+
+static unsigned long benchDestroyList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+
+    benchStart();
+    destroyList(list);
+    benchStop();
+
+    return size;
+}
+
+
+static unsigned long benchDestroyArenaList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = createListWithArena(sizeof(int), 0);
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+    {
+        int value = (int) i;
+        insertTop(list, &value);
+    }
+
+    /* the chunks are freed without visiting the nodes */
+    benchStart();
+    destroyList(list);
+    benchStop();
+
+    return size;
+}
+
+/**
+ * A stand-in for a per-request arena. Blocks are carved in order from one
+ * buffer and never released individually.
+ */
+typedef struct BumpArena {
+    char *block;
+    unsigned long used;
+    unsigned long capacity;
+} BumpArena;
+
+
+static void *bumpAllocate(void *context, unsigned long size)
+{
+    BumpArena *arena = context;
+
+    size = (size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    if (arena->used + size > arena->capacity)
+        return NULL;
+
+    arena->used += size;
+    return arena->block + arena->used - size;
+}
+
+
+static unsigned long benchInsertTopBumpAllocator(unsigned long size, BenchPattern pattern)
+{
+    BumpArena arena;
+    ListAllocator allocator;
+    LinkedList *list;
+    unsigned long i;
+
+    arena.capacity = size * sizeof(ListNode);
+    arena.block = malloc(arena.capacity);
+    arena.used = 0;
+    allocator.allocate = &bumpAllocate;
+    allocator.release = NULL;
+    allocator.context = &arena;
+    list = createListWithAllocator(&allocator, &free);
+
+    /* compare with insertTop, which calls malloc() for every node as well */
+    benchStart();
+    for (i = 0; i < size; i++)
+        insertTop(list, benchValue(i));
+    benchStop();
+
+    destroyList(list);
+    free(arena.block);
+    return size;
+}
+
+
+static unsigned long benchDestroyBumpAllocatorList(unsigned long size, BenchPattern pattern)
+{
+    BumpArena arena;
+    ListAllocator allocator;
+    LinkedList *list;
+    unsigned long i;
+
+    arena.capacity = size * sizeof(ListNode);
+    arena.block = malloc(arena.capacity);
+    arena.used = 0;
+    allocator.allocate = &bumpAllocate;
+    allocator.release = NULL;
+    allocator.context = &arena;
+    list = createListWithAllocator(&allocator, NULL);
+    for (i = 0; i < size; i++)
+        insertTop(list, (DataPointer) i);
+
+    /* the list does not own its data, so nothing is released node by node */
+    benchStart();
+    destroyList(list);
+    free(arena.block);
+    benchStop();
+
+    return size;
+}
+
+
+static unsigned long benchReduceUnrolledList(unsigned long size, BenchPattern pattern)
+{
+    UnrolledList *list = createUnrolledList();
+    long sum = 0;
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+        insertUnrolledTail(list, benchValue(i));
+
+    benchStart();
+    reduceUnrolledList(list, &sumReducer, &sum);
+    benchStop();
+
+    destroyUnrolledList(list);
+    return sum >= 0 ? size : 0;
+}
+
+
+/**
+ * Build an XOR list of @p size elements in order. Compare its memory use and
+ * speed with the doubly linked list of the switches build.
+ */
+static XorList *buildXorList(unsigned long size)
+{
+    XorList *list = createXorList();
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+        insertXorTail(list, benchValue(i));
+
+    return list;
+}
+
+
+static unsigned long benchInsertXorTail(unsigned long size, BenchPattern pattern)
+{
+    XorList *list = createXorList();
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < size; i++)
+        insertXorTail(list, benchValue(i));
+    benchStop();
+
+    destroyXorList(list);
+    return size;
+}
+
+
+static unsigned long benchRemoveXorTail(unsigned long size, BenchPattern pattern)
+{
+    XorList *list = buildXorList(size);
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < size; i++)
+        removeXorTail(list);
+    benchStop();
+
+    destroyXorList(list);
+    return size;
+}
+
+
+static unsigned long benchReduceXorList(unsigned long size, BenchPattern pattern)
+{
+    XorList *list = buildXorList(size);
+    long sum = 0;
+
+    benchStart();
+    reduceXorList(list, &sumReducer, &sum);
+    benchStop();
+
+    destroyXorList(list);
+    return sum >= 0 ? size : 0;
+}
+
+
+static unsigned long benchReduceXorListReverse(unsigned long size, BenchPattern pattern)
+{
+    XorList *list = buildXorList(size);
+    long sum = 0;
+
+    benchStart();
+    reduceXorListReverse(list, &sumReducer, &sum);
+    benchStop();
+
+    destroyXorList(list);
+    return sum >= 0 ? size : 0;
+}
+
+
+static unsigned long benchReduceInlineList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = createInlineList(sizeof(int));
+    long sum = 0;
+    unsigned long i;
+
+    /* the values are copied into the nodes, so the pattern has no effect */
+    for (i = 0; i < size; i++)
+    {
+        int value = (int) i;
+        insertTop(list, &value);
+    }
+
+    benchStart();
+    reduceList(list, &sumReducer, &sum);
+    benchStop();
+
+    destroyList(list);
+    return sum >= 0 ? size : 0;
+}
+
+static unsigned long benchInsertCompactTop(unsigned long size, BenchPattern pattern)
+{
+    CompactList *list = createCompactList(sizeof(int), 0);
+    unsigned long i;
+
+    /* growing the arrays is included in the cost */
+    benchStart();
+    for (i = 0; i < size; i++)
+    {
+        int value = (int) i;
+        insertCompactTop(list, &value);
+    }
+    benchStop();
+
+    destroyCompactList(list);
+    return size;
+}
+
+
+static unsigned long benchReduceCompactList(unsigned long size, BenchPattern pattern)
+{
+    CompactList *list = createCompactList(sizeof(int), 0);
+    long sum = 0;
+    unsigned long i;
+
+    /* compare with reduceInlineList, which stores the same values */
+    for (i = 0; i < size; i++)
+    {
+        int value = (int) i;
+        insertCompactTop(list, &value);
+    }
+
+    benchStart();
+    reduceCompactList(list, &sumReducer, &sum);
+    benchStop();
+
+    destroyCompactList(list);
+    return sum >= 0 ? size : 0;
+}
+
+static unsigned long benchReduceFrozenList(unsigned long size, BenchPattern pattern)
+{
+    FrozenList *list = freezeList(buildList(size));
+    long sum = 0;
+
+    benchStart();
+    reduceFrozenList(list, &sumReducer, &sum);
+    benchStop();
+
+    destroyFrozenList(list, NULL);
+    return sum >= 0 ? size : 0;
+}
+
+
+static unsigned long benchPeekFrozenIndex(unsigned long size, BenchPattern pattern)
+{
+    FrozenList *list = freezeList(buildList(size));
+    unsigned long index = 0;
+    long sum = 0;
+    unsigned long i;
+
+    /* stride through the list so consecutive lookups are far apart */
+    benchStart();
+    for (i = 0; i < size; i++)
+    {
+        sum += *(int *) peekFrozenIndex(list, (long) index);
+        index = (index + 7919) % size;
+    }
+    benchStop();
+
+    destroyFrozenList(list, NULL);
+    return sum >= 0 ? size : 0;
+}
+
+
+static int isEvenValue(DataPointer data, void *context)
+{
+    (void) context;
+    return *(int *) data % 2 == 0;
+}
+
+
+/* maps a value to its entry in a table, so no memory is allocated per element */
+static DataPointer lookupValue(DataPointer data, void *table)
+{
+    return (int *) table + *(int *) data;
+}
+
+
+/* the state of one stage of benchMapFilterStaged() */
+typedef struct StageContext {
+    ListCursor cursor;
+    int *table;
+} StageContext;
+
+
+static void *filterStageReducer(DataPointer data, void *context)
+{
+    StageContext *stage = (StageContext *) context;
+
+    if (isEvenValue(data, NULL))
+        cursorInsertBefore(&stage->cursor, data);
+    return context;
+}
+
+
+static void *mapStageReducer(DataPointer data, void *context)
+{
+    StageContext *stage = (StageContext *) context;
+
+    cursorInsertBefore(&stage->cursor, lookupValue(data, stage->table));
+    return context;
+}
+
+
+static int *buildTable(unsigned long size)
+{
+    int *table = malloc(size * sizeof(int));
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+        table[i] = (int) (i % 1000);
+
+    return table;
+}
+
+
+static unsigned long benchMapFilterStaged(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    int *table = buildTable(size);
+    LinkedList *filtered, *mapped;
+    StageContext stage;
+    long sum = 0;
+
+    stage.table = table;
+
+    /* each stage builds a list for the next, with one node per element */
+    benchStart();
+    filtered = createListWithAllocator(NULL, NULL);
+    initCursor(&stage.cursor, filtered);
+    reduceList(list, &filterStageReducer, &stage);
+    mapped = createListWithAllocator(NULL, NULL);
+    initCursor(&stage.cursor, mapped);
+    reduceList(filtered, &mapStageReducer, &stage);
+    reduceList(mapped, &sumReducer, &sum);
+    destroyList(filtered);
+    destroyList(mapped);
+    benchStop();
+
+    free(table);
+    destroyList(list);
+    return sum >= 0 ? size : 0;
+}
+
+
+static unsigned long benchMapFilterPipeline(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    int *table = buildTable(size);
+    Pipeline pipeline;
+    long sum = 0;
+
+    benchStart();
+    initPipeline(&pipeline, list);
+    pipelineFilter(&pipeline, &isEvenValue, NULL);
+    pipelineMap(&pipeline, &lookupValue, table);
+    reducePipeline(&pipeline, &sumReducer, &sum);
+    benchStop();
+
+    free(table);
+    destroyList(list);
+    return sum >= 0 ? size : 0;
+}
+
+static int intDifference(DataPointer a, DataPointer b)
+{
+    return *(int *) a - *(int *) b;
+}
+
+
+static int compareInts(const void *a, const void *b)
+{
+    return intDifference(*(DataPointer *) a, *(DataPointer *) b);
+}
+
+
+/**
+ * Build a list of @p size elements in a scrambled order.
+ */
+static LinkedList *buildUnsortedList(unsigned long size)
+{
+    LinkedList *list = createList();
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+        insertTop(list, benchValue((int) ((i * 2654435761UL) % size)));
+
+    return list;
+}
+
+
+static unsigned long benchSortList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildUnsortedList(size);
+
+    benchStart();
+    sortList(list, &intDifference);
+    benchStop();
+
+    destroyList(list);
+    return size;
+}
+
+
+static unsigned long benchQsortList(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildUnsortedList(size);
+    DataPointer *array = malloc(size * sizeof(DataPointer));
+    ListNode *node;
+    unsigned long i;
+
+    /* copy out to an array, sort that and write the order back */
+    benchStart();
+    for (node = list->head, i = 0; node; node = node->next)
+        array[i++] = node->data;
+    qsort(array, size, sizeof(DataPointer), &compareInts);
+    for (node = list->head, i = 0; node; node = node->next)
+        node->data = array[i++];
+    benchStop();
+
+    free(array);
+    destroyList(list);
+    return size;
+}
+
+/* Compare two values directly, so the comparison can be inlined */
+#define INT_COMPARE(a, b) ((a) - (b))
+#define RECORD_COMPARE(a, b) INT_COMPARE((a).key, (b).key)
+
+
+/**
+ * A struct payload, larger than a pointer, for comparing typed and generic
+ * lists.
+ */
+typedef struct BenchRecord {
+    int key;
+    double weight;
+    char tag[16];
+} BenchRecord;
+
+
+LL_DEFINE(IntList, int, INT_COMPARE)
+LL_DEFINE(RecordList, BenchRecord, RECORD_COMPARE)
+
+
+static int recordDifference(DataPointer a, DataPointer b)
+{
+    return ((BenchRecord *) a)->key - ((BenchRecord *) b)->key;
+}
+
+
+/**
+ * Build a typed list with the same scrambled order as buildUnsortedList().
+ */
+static void buildUnsortedIntList(IntList *list, unsigned long size)
+{
+    unsigned long i;
+
+    IntListInit(list);
+    for (i = 0; i < size; i++)
+        IntListInsertTop(list, (int) ((i * 2654435761UL) % size));
+}
+
+
+static unsigned long benchSortIntList(unsigned long size, BenchPattern pattern)
+{
+    IntList list;
+
+    buildUnsortedIntList(&list, size);
+
+    /* compare with sortList */
+    benchStart();
+    IntListSort(&list);
+    benchStop();
+
+    IntListClear(&list);
+    return size;
+}
+
+
+static unsigned long benchFindIntList(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = linearOps(size);
+    IntList list;
+    long found = 0;
+    unsigned long i;
+
+    IntListInit(&list);
+    for (i = size; i > 0; i--)
+        IntListInsertTop(&list, (int) (i - 1));
+
+    /* compare with findElement */
+    benchStart();
+    for (i = 0; i < ops; i++)
+        found += IntListFind(&list, (int) ((i * 7919) % size)) != NULL;
+    benchStop();
+
+    IntListClear(&list);
+    return (unsigned long) found == ops ? ops : 0;
+}
+
+
+static unsigned long benchReduceIntList(unsigned long size, BenchPattern pattern)
+{
+    IntList list;
+    IntListNode *node;
+    long sum = 0;
+
+    buildUnsortedIntList(&list, size);
+
+    /* compare with reduceList, summing in the loop rather than a callback */
+    benchStart();
+    LL_FOR_EACH(IntList, node, &list)
+        sum += node->value;
+    benchStop();
+
+    IntListClear(&list);
+    return sum >= 0 ? size : 0;
+}
+
+
+static unsigned long benchSortRecords(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = createList();
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+    {
+        BenchRecord *record = malloc(sizeof(BenchRecord));
+        record->key = (int) ((i * 2654435761UL) % size);
+        record->weight = (double) i;
+        insertTop(list, record);
+    }
+
+    benchStart();
+    sortList(list, &recordDifference);
+    benchStop();
+
+    destroyList(list);
+    return size;
+}
+
+
+static unsigned long benchSortRecordList(unsigned long size, BenchPattern pattern)
+{
+    RecordList list;
+    unsigned long i;
+
+    RecordListInit(&list);
+    for (i = 0; i < size; i++)
+    {
+        BenchRecord record;
+        record.key = (int) ((i * 2654435761UL) % size);
+        record.weight = (double) i;
+        RecordListInsertTop(&list, record);
+    }
+
+    /* compare with sortRecords, which sorts pointers to the same records */
+    benchStart();
+    RecordListSort(&list);
+    benchStop();
+
+    RecordListClear(&list);
+    return size;
+}
+
+
+static unsigned long benchInsertSkipSorted(unsigned long size, BenchPattern pattern)
+{
+    SkipList *list = createSkipList(&intDifference);
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < size; i++)
+        insertSkipSorted(list, benchValue((int) ((i * 2654435761UL) % size)));
+    benchStop();
+
+    destroySkipList(list);
+    return size;
+}
+
+
+static unsigned long benchFindSkipElement(unsigned long size, BenchPattern pattern)
+{
+    SkipList *list = createSkipList(&intDifference);
+    long found = 0;
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+        insertSkipSorted(list, benchValue((int) ((i * 2654435761UL) % size)));
+
+    benchStart();
+    for (i = 0; i < size; i++)
+    {
+        int needle = (int) ((i * 7919) % size);
+        found += findSkipElement(list, &needle) != NULL;
+    }
+    benchStop();
+
+    destroySkipList(list);
+    return (unsigned long) found == size ? size : 0;
+}
+
+static unsigned long intHash(DataPointer data)
+{
+    return (unsigned long) *(int *) data;
+}
+
+
+static unsigned long benchFindElement(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = linearOps(size);
+    LinkedList *list = buildList(size);
+    long found = 0;
+    unsigned long i;
+
+    benchStart();
+    for (i = 0; i < ops; i++)
+    {
+        int needle = (int) ((i * 7919) % size);
+        found += findElement(list, &needle, &intDifference) != NULL;
+    }
+    benchStop();
+
+    destroyList(list);
+    return (unsigned long) found == ops ? ops : 0;
+}
+
+
+static unsigned long benchFindElementIndexed(unsigned long size, BenchPattern pattern)
+{
+    LinkedList *list = buildList(size);
+    long found = 0;
+    unsigned long i;
+
+    attachHashIndex(list, &intHash, &intDifference);
+
+    benchStart();
+    for (i = 0; i < size; i++)
+    {
+        int needle = (int) ((i * 7919) % size);
+        found += findElement(list, &needle, NULL) != NULL;
+    }
+    benchStop();
+
+    destroyList(list);
+    return (unsigned long) found == size ? size : 0;
+}
+
+
+/* an element starting with a 64-bit key, as a keyed list requires */
+typedef struct KeyedValue {
+    int64_t key;
+    int value;
+} KeyedValue;
+
+
+static KeyedValue *keyedValue(unsigned long i)
+{
+    KeyedValue *element = malloc(sizeof(KeyedValue));
+
+    if (!element)
+        abort();
+
+    element->key = (int64_t) i * 2654435761UL;
+    element->value = (int) i;
+    return element;
+}
+
+
+static int keyDifference(DataPointer a, DataPointer b)
+{
+    int64_t left = ((KeyedValue *) a)->key;
+    int64_t right = ((KeyedValue *) b)->key;
+
+    return (left > right) - (left < right);
+}
+
+
+static unsigned long benchFindKeyScalarWalk(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = linearOps(size);
+    LinkedList *list = createList();
+    KeyedValue needle;
+    long found = 0;
+    unsigned long i;
+
+    for (i = size; i > 0; i--)
+        insertTop(list, keyedValue(i - 1));
+
+    /* a pointer hop and an indirect comparison per element */
+    benchStart();
+    for (i = 0; i < ops; i++)
+    {
+        needle.key = (int64_t) ((i * 7919) % size) * 2654435761UL;
+        found += findElement(list, &needle, &keyDifference) != NULL;
+    }
+    benchStop();
+
+    destroyList(list);
+    return (unsigned long) found == ops ? ops : 0;
+}
+
+
+/**
+ * Find keys spread through a keyed list with the search @p mode, or fail if it
+ * is not supported here.
+ */
+static unsigned long findKeys(unsigned long size, KeyedSearch mode)
+{
+    unsigned long ops = linearOps(size);
+    KeyedList *list = createKeyedList();
+    long found = 0;
+    unsigned long i;
+
+    if (!setKeyedSearch(mode))
+    {
+        destroyKeyedList(list);
+        return 0;
+    }
+
+    for (i = 0; i < size; i++)
+        insertKeyedTail(list, keyedValue(i));
+
+    benchStart();
+    for (i = 0; i < ops; i++)
+    {
+        int64_t key = (int64_t) ((i * 7919) % size) * 2654435761UL;
+        found += findKeyedElement(list, key) != NULL;
+    }
+    benchStop();
+
+    destroyKeyedList(list);
+    return (unsigned long) found == ops ? ops : 0;
+}
+
+
+static unsigned long benchFindKeyScalar(unsigned long size, BenchPattern pattern)
+{
+    return findKeys(size, KEYED_SEARCH_SCALAR);
+}
+
+
+static unsigned long benchFindKeySSE2(unsigned long size, BenchPattern pattern)
+{
+    return findKeys(size, KEYED_SEARCH_SSE2);
+}
+
+
+static unsigned long benchFindKeyAVX2(unsigned long size, BenchPattern pattern)
+{
+    return findKeys(size, KEYED_SEARCH_AVX2);
+}
+
+
+static unsigned long benchCountKeyedMatching(unsigned long size, BenchPattern pattern)
+{
+    unsigned long ops = linearOps(size);
+    KeyedList *list = createKeyedList();
+    unsigned long found = 0;
+    unsigned long i;
+
+    for (i = 0; i < size; i++)
+        insertKeyedTail(list, keyedValue(i));
+
+    /* every key is read on each call */
+    benchStart();
+    for (i = 0; i < ops; i++)
+        found += countKeyedMatching(list, (int64_t) ((i * 7919) % size) * 2654435761UL);
+    benchStop();
+
+    destroyKeyedList(list);
+    return found == ops ? ops : 0;
+}
+
+const Benchmark listBenchmarks[] = {
+    { "insertTop", &benchInsertTop },
+    { "insertTail", &benchInsertTail },
+    { "insertArrayTail", &benchInsertArrayTail },
+    { "removeTop", &benchRemoveTop },
+    { "removeTail", &benchRemoveTail },
+    { "peekTail", &benchPeekTail },
+    { "listLength", &benchListLength },
+    { "peekIndex", &benchPeekIndex },
+    { "peekNegativeIndex", &benchPeekNegativeIndex },
+    { "insertIndex", &benchInsertIndex },
+    { "reduceList", &benchReduceList },
+    { "reduceListParallel", &benchReduceListParallel },
+    { "scanList", &benchScanList },
+    { "scanCompactedList", &benchScanCompactedList },
+    { "compactList", &benchCompactList },
+    { "destroyList", &benchDestroyList },
+    { "destroyArenaList", &benchDestroyArenaList },
+    { "insertTopBumpAllocator", &benchInsertTopBumpAllocator },
+    { "destroyBumpAllocatorList", &benchDestroyBumpAllocatorList },
+    { "sortList", &benchSortList },
+    { "qsortList", &benchQsortList },
+    { "sortIntList", &benchSortIntList },
+    { "findIntList", &benchFindIntList },
+    { "reduceIntList", &benchReduceIntList },
+    { "sortRecords", &benchSortRecords },
+    { "sortRecordList", &benchSortRecordList },
+    { "insertSkipSorted", &benchInsertSkipSorted },
+    { "findSkipElement", &benchFindSkipElement },
+    { "findElement", &benchFindElement },
+    { "findElementIndexed", &benchFindElementIndexed },
+    { "findKeyScalarWalk", &benchFindKeyScalarWalk },
+    { "findKeyScalar", &benchFindKeyScalar },
+    { "findKeySSE2", &benchFindKeySSE2 },
+    { "findKeyAVX2", &benchFindKeyAVX2 },
+    { "countKeyedMatching", &benchCountKeyedMatching },
+    { "reduceUnrolledList", &benchReduceUnrolledList },
+    { "insertXorTail", &benchInsertXorTail },
+    { "removeXorTail", &benchRemoveXorTail },
+    { "reduceXorList", &benchReduceXorList },
+    { "reduceXorListReverse", &benchReduceXorListReverse },
+    { "reduceInlineList", &benchReduceInlineList },
+    { "insertCompactTop", &benchInsertCompactTop },
+    { "reduceCompactList", &benchReduceCompactList },
+    { "reduceFrozenList", &benchReduceFrozenList },
+    { "peekFrozenIndex", &benchPeekFrozenIndex },
+    { "mapFilterStaged", &benchMapFilterStaged },
+    { "mapFilterPipeline", &benchMapFilterPipeline },
+    { NULL, NULL }
+};
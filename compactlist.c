@@ -0,0 +1,273 @@
+/**
+ * @file    compactlist.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Compact list source file. The links and the elements are kept in
+ *          separate arrays, so a traversal only touches 4 bytes of link per
+ *          node besides the elements it visits.
+ */
+
+#include <string.h>
+#include "compactlist.h"
+
+
+/**
+ * Get the element stored in node @p index of @p list.
+ */
+static char *elementAt(CompactList *list, uint32_t index)
+{
+    return list->elements + (unsigned long) index * list->elementSize;
+}
+
+
+/**
+ * Resize the arrays of @p list to hold @p capacity nodes. Returns zero if
+ * memory could not be allocated, leaving the capacity as it was.
+ */
+static int resizeNodes(CompactList *list, uint32_t capacity)
+{
+    uint32_t *links;
+    char *elements;
+
+    /* the size of each array must fit in an unsigned long */
+    if (capacity > (unsigned long) -1 / (list->elementSize + sizeof(uint32_t)))
+        return FALSE;
+
+    links = (uint32_t *) realloc(list->links, capacity * sizeof(uint32_t));
+    if (!links)
+        return FALSE;
+    list->links = links;
+
+    elements = (char *) realloc(list->elements, capacity * list->elementSize);
+    if (!elements)
+        return FALSE;
+    list->elements = elements;
+
+    list->capacity = capacity;
+    return TRUE;
+}
+
+
+/**
+ * Take an unused node from @p list, growing the arrays if every node is in use.
+ * Returns `COMPACT_NONE` if there are no nodes left.
+ */
+static uint32_t allocIndex(CompactList *list)
+{
+    uint32_t index = list->free;
+
+    /* reuse released nodes first */
+    if (index != COMPACT_NONE)
+    {
+        list->free = list->links[index];
+        return index;
+    }
+
+    if (list->used == list->capacity)
+    {
+        uint32_t capacity = COMPACT_NONE;
+
+        /* double the capacity, stopping short of the missing node index */
+        if (list->capacity < COMPACT_NONE / 2)
+            capacity = list->capacity * 2;
+        if (list->capacity == capacity || !resizeNodes(list, capacity))
+            return COMPACT_NONE;
+    }
+
+    return list->used++;
+}
+
+
+/**
+ * Release node @p index of @p list for reuse.
+ */
+static void freeIndex(CompactList *list, uint32_t index)
+{
+    list->links[index] = list->free;
+    list->free = index;
+}
+
+
+CompactList* createCompactList(unsigned long elementSize, unsigned long initialCapacity)
+{
+    CompactList *list;
+
+    if (!elementSize)
+        return NULL;
+    if (!initialCapacity)
+        initialCapacity = COMPACT_DEFAULT_CAPACITY;
+    if (initialCapacity >= COMPACT_NONE)
+        return NULL;
+
+    /* allocate memory for the list */
+    list = (CompactList *) malloc(sizeof(CompactList));
+
+    /* if no error in allocating, initialise list contents */
+    if (list)
+    {
+        list->links = NULL;
+        list->elements = NULL;
+        list->elementSize = elementSize;
+        list->capacity = 0;
+        list->used = 0;
+        list->head = COMPACT_NONE;
+        list->tail = COMPACT_NONE;
+        list->free = COMPACT_NONE;
+        list->length = 0;
+
+        if (!resizeNodes(list, (uint32_t) initialCapacity))
+        {
+            destroyCompactList(list);
+            return NULL;
+        }
+    }
+
+    return list;
+}
+
+
+void *reduceCompactList(CompactList *list, Reducer callback, void *seed)
+{
+    uint32_t index;
+
+    if (!list)
+        return seed;
+
+    for (index = list->head; index != COMPACT_NONE; index = list->links[index])
+        seed = callback(elementAt(list, index), seed);
+
+    return seed;
+}
+
+
+int insertCompactTop(CompactList *list, DataPointer data)
+{
+    uint32_t index;
+
+    /* if list is NULL return immediately */
+    if (!list)
+        return FALSE;
+
+    index = allocIndex(list);
+    if (index == COMPACT_NONE)
+        return FALSE;
+
+    memcpy(elementAt(list, index), data, list->elementSize);
+    list->links[index] = list->head;
+    list->head = index;
+    if (list->tail == COMPACT_NONE)
+        list->tail = index;
+    list->length++;
+
+    return TRUE;
+}
+
+
+int insertCompactTail(CompactList *list, DataPointer data)
+{
+    uint32_t index;
+
+    /* if list is NULL return immediately */
+    if (!list)
+        return FALSE;
+
+    index = allocIndex(list);
+    if (index == COMPACT_NONE)
+        return FALSE;
+
+    memcpy(elementAt(list, index), data, list->elementSize);
+    list->links[index] = COMPACT_NONE;
+    if (list->tail == COMPACT_NONE)
+        list->head = index;
+    else
+        list->links[list->tail] = index;
+    list->tail = index;
+    list->length++;
+
+    return TRUE;
+}
+
+
+void destroyCompactList(CompactList *list)
+{
+    /* if list is not NULL */
+    if (list)
+    {
+        /* every node is part of the two arrays */
+        free(list->links);
+        free(list->elements);
+
+        /* free list struct */
+        free(list);
+    }
+}
+
+
+void removeCompactTop(CompactList *list)
+{
+    uint32_t top;
+
+    /* if list is not NULL or empty */
+    if (list && list->head != COMPACT_NONE)
+    {
+        top = list->head;
+        list->head = list->links[top];
+        if (list->head == COMPACT_NONE)
+            list->tail = COMPACT_NONE;
+
+        freeIndex(list, top);
+        list->length--;
+    }
+}
+
+
+void removeCompactTail(CompactList *list)
+{
+    uint32_t previous;
+
+    /* if list is not NULL or empty */
+    if (list && list->tail != COMPACT_NONE)
+    {
+        if (list->head == list->tail)
+        {
+            removeCompactTop(list);
+            return;
+        }
+
+        /* find the node before the tail */
+        previous = list->head;
+        while (list->links[previous] != list->tail)
+            previous = list->links[previous];
+
+        freeIndex(list, list->tail);
+        list->links[previous] = COMPACT_NONE;
+        list->tail = previous;
+        list->length--;
+    }
+}
+
+
+unsigned long compactListLength(CompactList *list)
+{
+    return list ? list->length : 0;
+}
+
+
+DataPointer peekCompactTop(CompactList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->head != COMPACT_NONE)
+        return elementAt(list, list->head);
+
+    return NULL;
+}
+
+
+DataPointer peekCompactTail(CompactList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->tail != COMPACT_NONE)
+        return elementAt(list, list->tail);
+
+    return NULL;
+}
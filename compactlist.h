@@ -0,0 +1,176 @@
+/**
+ * @file    compactlist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Compact list. The nodes live in one growable array and are linked
+ *          by 32-bit indexes, so each element costs 4 bytes on top of its own
+ *          size.
+ */
+
+
+#ifndef COMPACTLIST_H
+#define COMPACTLIST_H
+
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The number of nodes a compact list makes room for when none is given.
+ */
+#ifndef COMPACT_DEFAULT_CAPACITY
+    #define COMPACT_DEFAULT_CAPACITY 64
+#endif
+
+/**
+ * The index used for a missing node. The largest list is one node smaller.
+ */
+#define COMPACT_NONE UINT32_MAX
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` representing a compact list. The elements are stored inline in
+ * `elements`, `elementSize` bytes apart, and `links[i]` is the index of the
+ * node after node `i`. Nodes below `used` that are not in the list are chained
+ * together from `free` through `links`.
+ */
+typedef struct CompactList {
+    uint32_t *links;
+    char *elements;
+    unsigned long elementSize;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t free;
+    unsigned long length;
+} CompactList;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Create a new empty compact list.
+ *
+ * Elements are copied into the list, as for createInlineList(). The node array
+ * doubles in size whenever it is full.
+ *
+ * @param elementSize The size in bytes of each element, eg. `sizeof(int)`.
+ * @param initialCapacity The number of nodes to make room for straight away, or
+ *                        zero for `COMPACT_DEFAULT_CAPACITY`.
+ * @return A pointer to a new empty compact list or `NULL` on error, including
+ *         if @p elementSize is zero.
+ */
+CompactList* createCompactList(unsigned long elementSize, unsigned long initialCapacity);
+
+
+/**
+ * @brief Perform a reduce operation on a compact list.
+ *
+ * Behaves the same as reduceList(), calling @p callback with a pointer to each
+ * element in order.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each element in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceCompactList(CompactList *list, Reducer callback, void *seed);
+
+
+/**
+ * @brief Insert an element at the top of a compact list.
+ *
+ * @param list The list to add to.
+ * @param data A pointer to the element to copy into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertCompactTop(CompactList *list, DataPointer data);
+
+
+/**
+ * @brief Insert an element at the end of a compact list.
+ *
+ * @param list The list to add to.
+ * @param data A pointer to the element to copy into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertCompactTail(CompactList *list, DataPointer data);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete an entire compact list.
+ *
+ * Frees all the memory associated with @p list. The elements are part of the
+ * list, so nothing else needs freeing.
+ *
+ * @param list The list to delete.
+ */
+void destroyCompactList(CompactList *list);
+
+
+/**
+ * @brief Delete the element at the top of a compact list.
+ *
+ * If it exists, the first element is removed and its node is kept for reuse.
+ *
+ * @param list The list to remove from.
+ */
+void removeCompactTop(CompactList *list);
+
+
+/**
+ * @brief Delete the element at the end of a compact list.
+ *
+ * If it exists, the last element is removed and its node is kept for reuse.
+ * The nodes are only linked forwards, so the node before it must be searched
+ * for.
+ *
+ * @param list The list to remove from.
+ */
+void removeCompactTail(CompactList *list);
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+/**
+ * @brief Get the number of elements in a compact list.
+ *
+ * @param list The list to determine the length of.
+ * @return The size of the supplied list.
+ */
+unsigned long compactListLength(CompactList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the first element of a compact list.
+ *
+ * The element may move when the list grows, so the pointer is only valid until
+ * the next insertion.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the first element, or `NULL` if empty.
+ */
+DataPointer peekCompactTop(CompactList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the last element of a compact list.
+ *
+ * The element may move when the list grows, so the pointer is only valid until
+ * the next insertion.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the last element, or `NULL` if empty.
+ */
+DataPointer peekCompactTail(CompactList *list);
+
+
+#endif /* end of include guard: COMPACTLIST_H */
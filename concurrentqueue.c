@@ -0,0 +1,366 @@
+/**
+ * @file    concurrentqueue.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Lock-free queue source file. Nodes are reclaimed with hazard
+ *          pointers, and the GCC `__atomic` builtins are used for
+ *          compare-and-swap.
+ */
+
+#include "concurrentqueue.h"
+
+
+/* The number of retired nodes a thread keeps before scanning the hazards */
+#define RETIRE_THRESHOLD 64
+
+
+/**
+ * Compare two node pointers for sorting and searching.
+ */
+static int compareNodes(const void *a, const void *b)
+{
+    QueueNode *x = *(QueueNode * const *) a;
+    QueueNode *y = *(QueueNode * const *) b;
+
+    return (x > y) - (x < y);
+}
+
+
+/**
+ * Publish @p node as hazard number @p slot of @p record.
+ */
+static void protect(HazardRecord *record, int slot, QueueNode *node)
+{
+    __atomic_store_n(&record->hazards[slot], node, __ATOMIC_SEQ_CST);
+}
+
+
+/**
+ * Release the hazard record of a thread that has exited.
+ */
+static void releaseRecord(void *value)
+{
+    HazardRecord *record = (HazardRecord *) value;
+
+    protect(record, 0, NULL);
+    protect(record, 1, NULL);
+    __atomic_store_n(&record->active, FALSE, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * Get the hazard record of the calling thread, taking an unused one or adding
+ * a new one on first use. Returns `NULL` on error.
+ */
+static HazardRecord *acquireRecord(ConcurrentQueue *queue)
+{
+    HazardRecord *record = (HazardRecord *) pthread_getspecific(queue->key);
+    HazardRecord *head;
+    int inactive;
+
+    if (record)
+        return record;
+
+    /* reuse the record of a thread that has exited */
+    for (record = __atomic_load_n(&queue->records, __ATOMIC_ACQUIRE); record;
+            record = record->next)
+    {
+        inactive = FALSE;
+        if (!record->active && __atomic_compare_exchange_n(&record->active,
+                    &inactive, TRUE, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            break;
+    }
+
+    /* otherwise add a new record to the front of the list */
+    if (!record)
+    {
+        record = (HazardRecord *) malloc(sizeof(HazardRecord));
+        if (!record)
+            return NULL;
+
+        record->hazards[0] = NULL;
+        record->hazards[1] = NULL;
+        record->active = TRUE;
+        record->retired = NULL;
+        record->retiredCount = 0;
+        record->retiredCapacity = 0;
+
+        head = __atomic_load_n(&queue->records, __ATOMIC_ACQUIRE);
+        do
+            record->next = head;
+        while (!__atomic_compare_exchange_n(&queue->records, &head, record,
+                    TRUE, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+    }
+
+    if (pthread_setspecific(queue->key, record))
+    {
+        releaseRecord(record);
+        return NULL;
+    }
+
+    return record;
+}
+
+
+/**
+ * Free every node retired by @p record that no thread has as a hazard.
+ */
+static void scanRetired(ConcurrentQueue *queue, HazardRecord *record)
+{
+    HazardRecord *first;
+    HazardRecord *other;
+    QueueNode **hazards;
+    unsigned long count = 0;
+    unsigned long kept = 0;
+    unsigned long i;
+
+    /* records are only ever added to the front, so the list from first stays
+     * the same length; a thread that adds a record later can not reach a node
+     * that was retired before the scan began */
+    first = __atomic_load_n(&queue->records, __ATOMIC_ACQUIRE);
+    for (other = first; other; other = other->next)
+        count += 2;
+
+    hazards = (QueueNode **) malloc(count * sizeof(QueueNode *));
+    if (!hazards)
+        return;
+
+    /* take a snapshot of every hazard; records are never removed while the
+     * queue exists, so the list can be walked safely */
+    count = 0;
+    for (other = first; other; other = other->next)
+    {
+        hazards[count++] = __atomic_load_n(&other->hazards[0], __ATOMIC_SEQ_CST);
+        hazards[count++] = __atomic_load_n(&other->hazards[1], __ATOMIC_SEQ_CST);
+    }
+    qsort(hazards, count, sizeof(QueueNode *), &compareNodes);
+
+    for (i = 0; i < record->retiredCount; i++)
+    {
+        QueueNode *node = record->retired[i];
+
+        if (bsearch(&node, hazards, count, sizeof(QueueNode *), &compareNodes))
+            record->retired[kept++] = node;
+        else
+            free(node);
+    }
+    record->retiredCount = kept;
+
+    free(hazards);
+}
+
+
+/**
+ * Retire @p node, freeing it once no thread can be reading it.
+ */
+static void retireNode(ConcurrentQueue *queue, HazardRecord *record,
+        QueueNode *node)
+{
+    QueueNode **retired;
+
+    /* make room; if no memory can be found the node is leaked rather than
+     * freed while another thread may be reading it */
+    if (record->retiredCount == record->retiredCapacity)
+    {
+        unsigned long capacity = record->retiredCapacity ?
+            2 * record->retiredCapacity : RETIRE_THRESHOLD;
+
+        retired = (QueueNode **) realloc(record->retired,
+                capacity * sizeof(QueueNode *));
+        if (!retired)
+        {
+            scanRetired(queue, record);
+            if (record->retiredCount == record->retiredCapacity)
+                return;
+        }
+        else
+        {
+            record->retired = retired;
+            record->retiredCapacity = capacity;
+        }
+    }
+
+    record->retired[record->retiredCount++] = node;
+
+    if (record->retiredCount >= RETIRE_THRESHOLD &&
+            record->retiredCount * 2 >= record->retiredCapacity)
+        scanRetired(queue, record);
+}
+
+
+ConcurrentQueue* createConcurrentQueue()
+{
+    ConcurrentQueue *queue;
+    QueueNode *dummy;
+
+    /* allocate memory for the queue and its dummy node */
+    queue = (ConcurrentQueue *) malloc(sizeof(ConcurrentQueue));
+    dummy = (QueueNode *) malloc(sizeof(QueueNode));
+    if (!queue || !dummy || pthread_key_create(&queue->key, &releaseRecord))
+    {
+        free(queue);
+        free(dummy);
+        return NULL;
+    }
+
+    dummy->data = NULL;
+    dummy->next = NULL;
+    queue->head = dummy;
+    queue->tail = dummy;
+    queue->records = NULL;
+
+    return queue;
+}
+
+
+int enqueue(ConcurrentQueue *queue, DataPointer data)
+{
+    HazardRecord *record;
+    QueueNode *node;
+    QueueNode *tail;
+    QueueNode *next;
+
+    /* if queue is NULL return immediately */
+    if (!queue)
+        return FALSE;
+
+    record = acquireRecord(queue);
+    node = (QueueNode *) malloc(sizeof(QueueNode));
+    if (!record || !node)
+    {
+        free(node);
+        return FALSE;
+    }
+
+    node->data = data;
+    node->next = NULL;
+
+    for (;;)
+    {
+        /* protect the end, then check it was not removed in the meantime */
+        tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        protect(record, 0, tail);
+        if (tail != __atomic_load_n(&queue->tail, __ATOMIC_SEQ_CST))
+            continue;
+
+        next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+
+        /* help a lagging insertion along before trying again */
+        if (next)
+        {
+            __atomic_compare_exchange_n(&queue->tail, &tail, next, FALSE,
+                    __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (__atomic_compare_exchange_n(&tail->next, &next, node, FALSE,
+                    __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            break;
+    }
+
+    /* swing the end to the new node; another thread may already have */
+    __atomic_compare_exchange_n(&queue->tail, &tail, node, FALSE,
+            __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    protect(record, 0, NULL);
+
+    return TRUE;
+}
+
+
+void destroyConcurrentQueue(ConcurrentQueue *queue)
+{
+    HazardRecord *record;
+    QueueNode *node;
+    unsigned long i;
+
+    /* if queue is not NULL */
+    if (queue)
+    {
+        /* free the remaining nodes, skipping the dummy's data */
+        node = queue->head;
+        queue->head = node->next;
+        free(node);
+        while ((node = queue->head))
+        {
+            queue->head = node->next;
+            free(node->data);
+            free(node);
+        }
+
+        /* then everything left retired by each thread */
+        while ((record = queue->records))
+        {
+            queue->records = record->next;
+            for (i = 0; i < record->retiredCount; i++)
+                free(record->retired[i]);
+            free(record->retired);
+            free(record);
+        }
+
+        pthread_key_delete(queue->key);
+        free(queue);
+    }
+}
+
+
+DataPointer dequeue(ConcurrentQueue *queue)
+{
+    HazardRecord *record;
+    QueueNode *head;
+    QueueNode *tail;
+    QueueNode *next;
+    DataPointer data;
+
+    /* if queue is NULL return immediately */
+    if (!queue)
+        return NULL;
+
+    record = acquireRecord(queue);
+    if (!record)
+        return NULL;
+
+    for (;;)
+    {
+        /* protect the dummy, then check it was not removed in the meantime */
+        head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+        protect(record, 0, head);
+        if (head != __atomic_load_n(&queue->head, __ATOMIC_SEQ_CST))
+            continue;
+
+        tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+        protect(record, 1, next);
+        if (head != __atomic_load_n(&queue->head, __ATOMIC_SEQ_CST))
+            continue;
+
+        /* empty */
+        if (!next)
+        {
+            data = NULL;
+            break;
+        }
+
+        /* help a lagging insertion along before trying again */
+        if (head == tail)
+        {
+            __atomic_compare_exchange_n(&queue->tail, &tail, next, FALSE,
+                    __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        /* the first element becomes the new dummy */
+        data = next->data;
+        if (__atomic_compare_exchange_n(&queue->head, &head, next, FALSE,
+                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            protect(record, 0, NULL);
+            protect(record, 1, NULL);
+            retireNode(queue, record, head);
+            return data;
+        }
+    }
+
+    protect(record, 0, NULL);
+    protect(record, 1, NULL);
+    return data;
+}
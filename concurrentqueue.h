@@ -0,0 +1,123 @@
+/**
+ * @file    concurrentqueue.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Lock-free first-in first-out queue allowing many threads to insert
+ *          at the end and remove from the top at once.
+ */
+
+
+#ifndef CONCURRENTQUEUE_H
+#define CONCURRENTQUEUE_H
+
+
+#include <pthread.h>
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The number of bytes separating the top and end of a queue so that threads
+ * inserting and removing do not contend for the same cache line.
+ */
+#ifndef QUEUE_CACHE_LINE
+    #define QUEUE_CACHE_LINE 64
+#endif
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` representing a node within a concurrent queue.
+ */
+typedef struct QueueNode {
+    DataPointer data;
+    struct QueueNode * volatile next;
+} QueueNode;
+
+
+/**
+ * A `struct` holding the hazard pointers and retired nodes of one thread.
+ *
+ * A thread publishes the nodes it is about to read as hazards. Nodes removed
+ * from the queue are retired rather than freed, and only freed once no thread
+ * has them as a hazard.
+ */
+typedef struct HazardRecord {
+    QueueNode * volatile hazards[2];
+    volatile int active;
+    struct HazardRecord *next;
+    QueueNode **retired;
+    unsigned long retiredCount;
+    unsigned long retiredCapacity;
+} HazardRecord;
+
+
+/**
+ * A `struct` representing a lock-free queue (a Michael-Scott queue).
+ *
+ * The queue always holds a dummy node at its top; the first element is in the
+ * node after it. Each thread using the queue is given a `HazardRecord` on
+ * first use, which is handed to another thread when it exits.
+ */
+typedef struct ConcurrentQueue {
+    QueueNode * volatile head;
+    char padding[QUEUE_CACHE_LINE - sizeof(QueueNode *)];
+    QueueNode * volatile tail;
+    HazardRecord * volatile records;
+    pthread_key_t key;
+} ConcurrentQueue;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Create a new empty concurrent queue.
+ *
+ * Each queue uses a thread-specific data key, so the number of queues that
+ * can exist at once is limited by `PTHREAD_KEYS_MAX`.
+ *
+ * @return A pointer to a new empty queue or `NULL` on error.
+ */
+ConcurrentQueue* createConcurrentQueue();
+
+
+/**
+ * @brief Insert an element at the end of a concurrent queue.
+ *
+ * Safe to call from any number of threads at once.
+ *
+ * @param queue The queue to add to.
+ * @param data The data to insert.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int enqueue(ConcurrentQueue *queue, DataPointer data);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete a concurrent queue.
+ *
+ * Frees all the memory associated with @p queue, including the data of each
+ * remaining element. No other thread may be using the queue.
+ *
+ * @param queue The queue to delete.
+ */
+void destroyConcurrentQueue(ConcurrentQueue *queue);
+
+
+/**
+ * @brief Remove and return the element at the top of a concurrent queue.
+ *
+ * Safe to call from any number of threads at once. The data is not freed;
+ * the caller becomes responsible for it.
+ *
+ * @param queue The queue to remove from.
+ * @return A pointer to the removed element, or `NULL` if empty.
+ */
+DataPointer dequeue(ConcurrentQueue *queue);
+
+
+#endif /* end of include guard: CONCURRENTQUEUE_H */
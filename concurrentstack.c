@@ -0,0 +1,228 @@
+/**
+ * @file    concurrentstack.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Lock-free stack source file. Uses the GCC `__atomic` builtins for
+ *          compare-and-swap.
+ */
+
+#include "concurrentstack.h"
+
+
+/* Split a tagged reference into its parts, or build one */
+#define REFERENCE(word) ((uint32_t) ((word) & 0xFFFFFFFFUL))
+#define TAG(word) ((uint32_t) ((word) >> 32))
+#define TAGGED(tag, reference) (((uint64_t) (tag) << 32) | (reference))
+
+
+/**
+ * Find the segment holding the node at @p index, and its offset within it.
+ */
+static unsigned int segmentOf(uint32_t index, uint32_t *offset)
+{
+    uint32_t block = index / STACK_SEGMENT_BASE + 1;
+    unsigned int segment = 0;
+
+    /* segment k starts at block 2^k - 1 */
+    while (block >> (segment + 1))
+        segment++;
+
+    *offset = index - STACK_SEGMENT_BASE * ((1UL << segment) - 1);
+    return segment;
+}
+
+
+/**
+ * Get the node for a non-zero reference.
+ */
+static StackNode *nodeAt(ConcurrentStack *stack, uint32_t reference)
+{
+    uint32_t offset;
+    unsigned int segment = segmentOf(reference - 1, &offset);
+
+    return &__atomic_load_n(&stack->segments[segment], __ATOMIC_ACQUIRE)[offset];
+}
+
+
+/**
+ * Make sure the segment holding @p index exists. Returns zero if it could not
+ * be allocated.
+ */
+static int ensureSegment(ConcurrentStack *stack, uint32_t index)
+{
+    uint32_t offset;
+    unsigned int segment = segmentOf(index, &offset);
+    StackNode *nodes;
+    StackNode *expected = NULL;
+
+    if (segment >= STACK_SEGMENTS)
+        return FALSE;
+    if (__atomic_load_n(&stack->segments[segment], __ATOMIC_ACQUIRE))
+        return TRUE;
+
+    nodes = (StackNode *) malloc((STACK_SEGMENT_BASE << segment) * sizeof(StackNode));
+    if (!nodes)
+        return FALSE;
+
+    /* another thread may have added the segment first */
+    if (!__atomic_compare_exchange_n(&stack->segments[segment], &expected,
+                nodes, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        free(nodes);
+
+    return TRUE;
+}
+
+
+/**
+ * Push the node @p reference onto the stack whose top is at @p top.
+ */
+static void pushReference(ConcurrentStack *stack, volatile uint64_t *top,
+        uint32_t reference)
+{
+    StackNode *node = nodeAt(stack, reference);
+    uint64_t old = __atomic_load_n(top, __ATOMIC_ACQUIRE);
+
+    do
+        __atomic_store_n(&node->next, REFERENCE(old), __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(top, &old,
+                TAGGED(TAG(old) + 1, reference), TRUE, __ATOMIC_RELEASE,
+                __ATOMIC_ACQUIRE));
+}
+
+
+/**
+ * Pop a node from the stack whose top is at @p top, returning its reference or
+ * zero if empty.
+ */
+static uint32_t popReference(ConcurrentStack *stack, volatile uint64_t *top)
+{
+    uint64_t old = __atomic_load_n(top, __ATOMIC_ACQUIRE);
+    uint32_t next;
+
+    do
+    {
+        if (!REFERENCE(old))
+            return 0;
+
+        /* the node may be reused before the swap, but then the tag differs */
+        next = __atomic_load_n(&nodeAt(stack, REFERENCE(old))->next, __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(top, &old, TAGGED(TAG(old) + 1, next),
+                TRUE, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+    return REFERENCE(old);
+}
+
+
+/**
+ * Get an unused node, returning its reference or zero on error.
+ */
+static uint32_t allocReference(ConcurrentStack *stack)
+{
+    uint32_t reference = popReference(stack, &stack->free);
+    uint32_t index;
+
+    if (reference)
+        return reference;
+
+    /* take a node that has never been used */
+    index = __atomic_fetch_add(&stack->allocated, 1, __ATOMIC_RELAXED);
+    if (index == 0xFFFFFFFFUL || !ensureSegment(stack, index))
+        return 0;
+
+    return index + 1;
+}
+
+
+ConcurrentStack* createConcurrentStack(unsigned long initialCapacity)
+{
+    ConcurrentStack *stack;
+    unsigned long i;
+
+    /* allocate memory for the stack */
+    stack = (ConcurrentStack *) malloc(sizeof(ConcurrentStack));
+    if (!stack)
+        return NULL;
+
+    stack->top = 0;
+    stack->free = 0;
+    stack->allocated = 0;
+    for (i = 0; i < STACK_SEGMENTS; i++)
+        stack->segments[i] = NULL;
+
+    /* allocate the segments covering the initial capacity */
+    for (i = 0; i < initialCapacity; i = 2 * i + STACK_SEGMENT_BASE)
+    {
+        if (!ensureSegment(stack, (uint32_t) i))
+        {
+            destroyConcurrentStack(stack);
+            return NULL;
+        }
+    }
+
+    return stack;
+}
+
+
+int insertConcurrentTop(ConcurrentStack *stack, DataPointer data)
+{
+    uint32_t reference;
+
+    /* if stack is NULL return immediately */
+    if (!stack)
+        return FALSE;
+
+    reference = allocReference(stack);
+    if (!reference)
+        return FALSE;
+
+    nodeAt(stack, reference)->data = data;
+    pushReference(stack, &stack->top, reference);
+
+    return TRUE;
+}
+
+
+void destroyConcurrentStack(ConcurrentStack *stack)
+{
+    unsigned int i;
+
+    /* if stack is not NULL */
+    if (stack)
+    {
+        /* free the data of every remaining element */
+        while (REFERENCE(stack->top))
+            removeConcurrentTop(stack);
+
+        for (i = 0; i < STACK_SEGMENTS; i++)
+            free(stack->segments[i]);
+
+        free(stack);
+    }
+}
+
+
+DataPointer popConcurrentTop(ConcurrentStack *stack)
+{
+    uint32_t reference;
+    DataPointer data;
+
+    /* if stack is NULL return immediately */
+    if (!stack)
+        return NULL;
+
+    reference = popReference(stack, &stack->top);
+    if (!reference)
+        return NULL;
+
+    /* the node belongs to this thread until it is put on the free list */
+    data = nodeAt(stack, reference)->data;
+    pushReference(stack, &stack->free, reference);
+
+    return data;
+}
+
+
+void removeConcurrentTop(ConcurrentStack *stack)
+{
+    free(popConcurrentTop(stack));
+}
@@ -0,0 +1,131 @@
+/**
+ * @file    concurrentstack.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Lock-free stack allowing many threads to insert and remove at the
+ *          top of a list at once.
+ */
+
+
+#ifndef CONCURRENTSTACK_H
+#define CONCURRENTSTACK_H
+
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The number of nodes in the first segment of a stack's node table. Each
+ * following segment is twice the size of the one before.
+ */
+#ifndef STACK_SEGMENT_BASE
+    #define STACK_SEGMENT_BASE 64
+#endif
+
+/**
+ * The number of segments in a stack's node table. This bounds the number of
+ * nodes a stack can hold, which can not exceed 2^32 - 1 as nodes are addressed
+ * by a 32-bit index.
+ */
+#ifndef STACK_SEGMENTS
+    #define STACK_SEGMENTS 26
+#endif
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` representing a node within a concurrent stack. Nodes refer to
+ * each other by index plus one, with zero meaning no node.
+ */
+typedef struct StackNode {
+    DataPointer data;
+    uint32_t next;
+} StackNode;
+
+
+/**
+ * A `struct` representing a lock-free stack (a Treiber stack).
+ *
+ * The top of the stack and the internal free list are each a 64-bit word
+ * holding a node reference in the low 32 bits and a tag in the high 32 bits.
+ * The tag is incremented on every change so a compare-and-swap fails if the
+ * top was removed and re-inserted in between (the ABA problem).
+ *
+ * Nodes live in a table of segments that is only freed when the stack is
+ * destroyed. Removed nodes are recycled through the free list, so a thread
+ * holding a stale reference can always read the node safely; the tag check
+ * then rejects it.
+ */
+typedef struct ConcurrentStack {
+    volatile uint64_t top;
+    volatile uint64_t free;
+    volatile uint32_t allocated;
+    StackNode * volatile segments[STACK_SEGMENTS];
+} ConcurrentStack;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Create a new empty concurrent stack.
+ *
+ * @param initialCapacity The number of nodes to allocate up front. Further
+ *                        nodes are allocated as required.
+ * @return A pointer to a new empty stack or `NULL` on error.
+ */
+ConcurrentStack* createConcurrentStack(unsigned long initialCapacity);
+
+
+/**
+ * @brief Insert an element at the top of a concurrent stack.
+ *
+ * Safe to call from any number of threads at once.
+ *
+ * @param stack The stack to add to.
+ * @param data The data to insert.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertConcurrentTop(ConcurrentStack *stack, DataPointer data);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete a concurrent stack.
+ *
+ * Frees all the memory associated with @p stack, including the data of each
+ * remaining element. No other thread may be using the stack.
+ *
+ * @param stack The stack to delete.
+ */
+void destroyConcurrentStack(ConcurrentStack *stack);
+
+
+/**
+ * @brief Remove and return the element at the top of a concurrent stack.
+ *
+ * Safe to call from any number of threads at once. The data is not freed;
+ * the caller becomes responsible for it.
+ *
+ * @param stack The stack to remove from.
+ * @return A pointer to the removed element, or `NULL` if empty.
+ */
+DataPointer popConcurrentTop(ConcurrentStack *stack);
+
+
+/**
+ * @brief Delete the element at the top of a concurrent stack.
+ *
+ * Safe to call from any number of threads at once. If it exists, the top
+ * element is removed and `free()` is called on its data.
+ *
+ * @param stack The stack to remove from.
+ */
+void removeConcurrentTop(ConcurrentStack *stack);
+
+
+#endif /* end of include guard: CONCURRENTSTACK_H */
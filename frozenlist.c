@@ -0,0 +1,83 @@
+/**
+ * @file    frozenlist.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Frozen list source file. The elements are an array of pointers, so
+ *          a scan reads memory in order and can prefetch the elements ahead.
+ */
+
+#include "frozenlist.h"
+
+
+/* Prefetch the memory at @p address for reading, where supported */
+#ifdef __GNUC__
+    #define PREFETCH(address) __builtin_prefetch(address)
+#else
+    #define PREFETCH(address)
+#endif
+
+
+FrozenList *freezeList(LinkedList *list)
+{
+    return list2Array(list);
+}
+
+
+void *reduceFrozenList(const FrozenList *list, Reducer callback, void *seed)
+{
+    unsigned long i;
+
+    if (!list)
+        return seed;
+
+    for (i = 0; i < list->length; i++)
+    {
+        /* inline elements are already contiguous */
+        if (!list->elementSize && i + FROZEN_PREFETCH_DISTANCE < list->length)
+            PREFETCH(list->elements[i + FROZEN_PREFETCH_DISTANCE]);
+
+        seed = callback(list->elements[i], seed);
+    }
+
+    return seed;
+}
+
+
+void destroyFrozenList(FrozenList *list, FreeDataFunc freeData)
+{
+    destroyArray(list, freeData);
+}
+
+
+unsigned long frozenListLength(const FrozenList *list)
+{
+    return list ? list->length : 0;
+}
+
+
+DataPointer peekFrozenIndex(const FrozenList *list, long index)
+{
+    if (!list)
+        return NULL;
+
+    /* count negative indexes back from the end */
+    if (index < 0)
+        index += (long) list->length;
+
+    if (index < 0 || (unsigned long) index >= list->length)
+        return NULL;
+
+    return list->elements[index];
+}
+
+
+DataPointer peekFrozenTop(const FrozenList *list)
+{
+    return peekFrozenIndex(list, 0);
+}
+
+
+DataPointer peekFrozenTail(const FrozenList *list)
+{
+    return peekFrozenIndex(list, -1);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file    frozenlist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Read-only list stored contiguously. A frozen list is built once
+ *          from a linked list and then supports constant time indexing and
+ *          sequential scans.
+ */
+
+
+#ifndef FROZENLIST_H
+#define FROZENLIST_H
+
+
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * How many elements ahead of the current one reduceFrozenList() prefetches
+ * when the elements are stored outside the array.
+ */
+#ifndef FROZEN_PREFETCH_DISTANCE
+    #define FROZEN_PREFETCH_DISTANCE 8
+#endif
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A frozen list is the `ArrayList` produced by list2Array(). The functions
+ * below never modify it.
+ */
+typedef ArrayList FrozenList;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Convert a linked list into a frozen list.
+ *
+ * The elements of @p list are moved into a new frozen list in the same order,
+ * as for list2Array(). If an error occurs the list is left unmodified and
+ * `NULL` is returned.
+ *
+ * @param list The list to freeze. It is freed on success.
+ * @return A pointer to the new frozen list, or `NULL` on error.
+ */
+FrozenList *freezeList(LinkedList *list);
+
+
+/**
+ * @brief Perform a reduce operation on a frozen list.
+ *
+ * Behaves the same as reduceList(), scanning the elements in order.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each element in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceFrozenList(const FrozenList *list, Reducer callback, void *seed);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete an entire frozen list.
+ *
+ * Behaves the same as destroyArray().
+ *
+ * @param list The list to delete.
+ * @param freeData The user defined callback to free each element, or `NULL` to
+ *                 use the `freeData` of the frozen list.
+ */
+void destroyFrozenList(FrozenList *list, FreeDataFunc freeData);
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+/**
+ * @brief Get the number of elements in a frozen list.
+ *
+ * @param list The list to determine the length of.
+ * @return The size of the supplied list.
+ */
+unsigned long frozenListLength(const FrozenList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the element at an index.
+ *
+ * Constant time. Negative indexes count back from the end of the list, so -1
+ * is the last element.
+ *
+ * @param list The list to retrieve from.
+ * @param index The index of the element (starting at 0).
+ * @return A pointer to the element, or `NULL` if @p index is out of bounds.
+ */
+DataPointer peekFrozenIndex(const FrozenList *list, long index);
+
+
+/**
+ * @brief Retrieves, but does not remove, the first element of a frozen list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the first element, or `NULL` if empty.
+ */
+DataPointer peekFrozenTop(const FrozenList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the last element of a frozen list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the last element, or `NULL` if empty.
+ */
+DataPointer peekFrozenTail(const FrozenList *list);
+
+
+#endif /* end of include guard: FROZENLIST_H */
@@ -0,0 +1,126 @@
+/**
+ * @file    intrusivelist.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Intrusive list source file. The sentinel link means insertion and
+ *          removal never need to special case the ends of the list.
+ */
+
+#include "intrusivelist.h"
+
+
+/**
+ * Link @p link between the adjacent links @p prev and @p next.
+ */
+static void linkBetween(IntrusiveList *list, ListLink *prev, ListLink *next,
+        ListLink *link)
+{
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+    list->length++;
+}
+
+
+void initIntrusiveList(IntrusiveList *list)
+{
+    if (list)
+    {
+        list->sentinel.next = &list->sentinel;
+        list->sentinel.prev = &list->sentinel;
+        list->length = 0;
+    }
+}
+
+
+void *reduceIntrusiveList(IntrusiveList *list, LinkReducer callback, void *seed)
+{
+    ListLink *link;
+
+    if (!list)
+        return seed;
+
+    INTRUSIVE_FOR_EACH(link, list)
+        seed = callback(link, seed);
+
+    return seed;
+}
+
+
+void insertIntrusiveTop(IntrusiveList *list, ListLink *link)
+{
+    if (list && link)
+        linkBetween(list, &list->sentinel, list->sentinel.next, link);
+}
+
+
+void insertIntrusiveTail(IntrusiveList *list, ListLink *link)
+{
+    if (list && link)
+        linkBetween(list, list->sentinel.prev, &list->sentinel, link);
+}
+
+
+void insertIntrusiveAfter(IntrusiveList *list, ListLink *position, ListLink *link)
+{
+    if (list && position && link)
+        linkBetween(list, position, position->next, link);
+}
+
+
+void unlinkIntrusive(IntrusiveList *list, ListLink *link)
+{
+    if (list && link && link != &list->sentinel)
+    {
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+        link->next = NULL;
+        link->prev = NULL;
+        list->length--;
+    }
+}
+
+
+ListLink *popIntrusiveTop(IntrusiveList *list)
+{
+    ListLink *top = peekIntrusiveTop(list);
+
+    unlinkIntrusive(list, top);
+    return top;
+}
+
+
+ListLink *popIntrusiveTail(IntrusiveList *list)
+{
+    ListLink *tail = peekIntrusiveTail(list);
+
+    unlinkIntrusive(list, tail);
+    return tail;
+}
+
+
+unsigned long intrusiveListLength(IntrusiveList *list)
+{
+    return list ? list->length : 0;
+}
+
+
+ListLink *peekIntrusiveTop(IntrusiveList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->length)
+        return list->sentinel.next;
+
+    return NULL;
+}
+
+
+ListLink *peekIntrusiveTail(IntrusiveList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->length)
+        return list->sentinel.prev;
+
+    return NULL;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file    intrusivelist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Intrusive doubly linked list. The links are embedded in the user's
+ *          own `struct`s so the list never allocates memory.
+ */
+
+
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+
+#include <stddef.h>
+#include "linkedlist.h"
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` embedded in each element of an intrusive list. An element can be
+ * in as many lists at once as it has links.
+ */
+typedef struct ListLink {
+    struct ListLink *next;
+    struct ListLink *prev;
+} ListLink;
+
+
+/**
+ * A `struct` representing an intrusive list. The list is circular through
+ * `sentinel`, so an empty list's sentinel points to itself.
+ */
+typedef struct IntrusiveList {
+    ListLink sentinel;
+    unsigned long length;
+} IntrusiveList;
+
+
+/**
+ * @brief A function pointer type used to reduce an intrusive list to a single
+ *        value.
+ *
+ * As for `Reducer`, but the first argument is the link of the current element.
+ * Use INTRUSIVE_ENTRY() to get the element itself.
+ */
+typedef void *(* LinkReducer)(ListLink *, void *);
+
+
+/**
+ * @brief Get the element containing a link.
+ *
+ * @param link A pointer to the `ListLink` within the element.
+ * @param type The `struct` type of the element.
+ * @param member The name of the `ListLink` member within @p type.
+ * @return A pointer to the element of type @p type.
+ */
+#define INTRUSIVE_ENTRY(link, type, member) \
+    ((type *) ((char *) (link) - offsetof(type, member)))
+
+
+/**
+ * @brief Iterate over the links of an intrusive list in order.
+ *
+ * The current link must not be unlinked within the loop body.
+ *
+ * @param link A `ListLink *` variable set to each link in turn.
+ * @param list A pointer to the list to iterate over.
+ */
+#define INTRUSIVE_FOR_EACH(link, list) \
+    for ((link) = (list)->sentinel.next; (link) != &(list)->sentinel; \
+            (link) = (link)->next)
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Initialise an empty intrusive list.
+ *
+ * The list may be part of any other `struct` or on the stack; it is not
+ * allocated by the library.
+ *
+ * @param list The list to initialise.
+ */
+void initIntrusiveList(IntrusiveList *list);
+
+
+/**
+ * @brief Perform a reduce operation on an intrusive list.
+ *
+ * Behaves the same as reduceList(), passing each element's link to
+ * @p callback in order.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each link in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceIntrusiveList(IntrusiveList *list, LinkReducer callback, void *seed);
+
+
+/**
+ * @brief Link an element at the top of an intrusive list.
+ *
+ * @param list The list to add to.
+ * @param link The link of the element, which must not be in another list.
+ */
+void insertIntrusiveTop(IntrusiveList *list, ListLink *link);
+
+
+/**
+ * @brief Link an element at the end of an intrusive list.
+ *
+ * @param list The list to add to.
+ * @param link The link of the element, which must not be in another list.
+ */
+void insertIntrusiveTail(IntrusiveList *list, ListLink *link);
+
+
+/**
+ * @brief Link an element directly after another in an intrusive list.
+ *
+ * @param list The list to add to.
+ * @param position The link of an element already in @p list.
+ * @param link The link of the element, which must not be in another list.
+ */
+void insertIntrusiveAfter(IntrusiveList *list, ListLink *position, ListLink *link);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Unlink an element from an intrusive list.
+ *
+ * Constant time, as the element knows its neighbours. The element itself is
+ * not freed.
+ *
+ * @param list The list containing the element.
+ * @param link The link of the element to remove.
+ */
+void unlinkIntrusive(IntrusiveList *list, ListLink *link);
+
+
+/**
+ * @brief Unlink and return the element at the top of an intrusive list.
+ *
+ * @param list The list to remove from.
+ * @return The link of the removed element, or `NULL` if empty.
+ */
+ListLink *popIntrusiveTop(IntrusiveList *list);
+
+
+/**
+ * @brief Unlink and return the element at the end of an intrusive list.
+ *
+ * @param list The list to remove from.
+ * @return The link of the removed element, or `NULL` if empty.
+ */
+ListLink *popIntrusiveTail(IntrusiveList *list);
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+/**
+ * @brief Get the number of elements in an intrusive list.
+ *
+ * @param list The list to determine the length of.
+ * @return The size of the supplied list.
+ */
+unsigned long intrusiveListLength(IntrusiveList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the first element of an intrusive
+ *        list.
+ *
+ * @param list The list to retrieve from.
+ * @return The link of the first element, or `NULL` if empty.
+ */
+ListLink *peekIntrusiveTop(IntrusiveList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the last element of an intrusive
+ *        list.
+ *
+ * @param list The list to retrieve from.
+ * @return The link of the last element, or `NULL` if empty.
+ */
+ListLink *peekIntrusiveTail(IntrusiveList *list);
+
+
+#endif /* end of include guard: INTRUSIVELIST_H */
@@ -0,0 +1,460 @@
+/**
+ * @file    keyedlist.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Keyed list source file. A search walks the chunks, handing each
+ *          array of keys to a kernel chosen for the processor at runtime.
+ */
+
+#include "keyedlist.h"
+
+
+/* Build the vector searches where the compiler can target them */
+#if !defined(KEYED_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+    #define KEYED_X86
+    #include <immintrin.h>
+#endif
+
+
+/* Returns the index of the first of @p count keys equal to @p key, or @p count */
+typedef unsigned int (* FindKernel)(const int64_t *keys, unsigned int count, int64_t key);
+
+/* Returns the number of @p count keys equal to @p key */
+typedef unsigned int (* CountKernel)(const int64_t *keys, unsigned int count, int64_t key);
+
+
+/***** SEARCH KERNELS *****/
+
+static unsigned int findScalar(const int64_t *keys, unsigned int count, int64_t key)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (keys[i] == key)
+            break;
+    }
+
+    return i;
+}
+
+
+static unsigned int countScalar(const int64_t *keys, unsigned int count, int64_t key)
+{
+    unsigned int matches = 0;
+    unsigned int i;
+
+    for (i = 0; i < count; i++)
+        matches += keys[i] == key;
+
+    return matches;
+}
+
+
+#ifdef KEYED_X86
+
+/**
+ * Compare two keys against @p needle, giving a 2-bit mask of the equal ones.
+ * SSE2 has no 64-bit comparison, so both 32-bit halves must match.
+ */
+static unsigned int matchSSE2(const int64_t *keys, __m128i needle)
+{
+    __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) keys), needle);
+
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (unsigned int) _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+
+/* Compare four keys against @p needle, giving a 4-bit mask of the equal ones */
+__attribute__((target("avx2")))
+static unsigned int matchAVX2(const int64_t *keys, __m256i needle)
+{
+    __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *) keys), needle);
+
+    return (unsigned int) _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+}
+
+
+/* SSE2 is part of x86-64, so these need no check before use */
+static unsigned int findSSE2(const int64_t *keys, unsigned int count, int64_t key)
+{
+    __m128i needle = _mm_set1_epi64x(key);
+    unsigned int mask;
+    unsigned int i;
+
+    /* eight keys are tested per iteration */
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        mask = matchSSE2(keys + i, needle)
+            | matchSSE2(keys + i + 2, needle) << 2
+            | matchSSE2(keys + i + 4, needle) << 4
+            | matchSSE2(keys + i + 6, needle) << 6;
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+
+    return i + findScalar(keys + i, count - i, key);
+}
+
+
+static unsigned int countSSE2(const int64_t *keys, unsigned int count, int64_t key)
+{
+    __m128i needle = _mm_set1_epi64x(key);
+    unsigned int matches = 0;
+    unsigned int i;
+
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        matches += __builtin_popcount(matchSSE2(keys + i, needle)
+                | matchSSE2(keys + i + 2, needle) << 2
+                | matchSSE2(keys + i + 4, needle) << 4
+                | matchSSE2(keys + i + 6, needle) << 6);
+    }
+
+    return matches + countScalar(keys + i, count - i, key);
+}
+
+
+__attribute__((target("avx2")))
+static unsigned int findAVX2(const int64_t *keys, unsigned int count, int64_t key)
+{
+    __m256i needle = _mm256_set1_epi64x(key);
+    unsigned int mask;
+    unsigned int i;
+
+    /* eight keys are tested per iteration */
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        mask = matchAVX2(keys + i, needle)
+            | matchAVX2(keys + i + 4, needle) << 4;
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+
+    return i + findScalar(keys + i, count - i, key);
+}
+
+
+__attribute__((target("avx2")))
+static unsigned int countAVX2(const int64_t *keys, unsigned int count, int64_t key)
+{
+    __m256i needle = _mm256_set1_epi64x(key);
+    unsigned int matches = 0;
+    unsigned int i;
+
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        matches += __builtin_popcount(matchAVX2(keys + i, needle)
+                | matchAVX2(keys + i + 4, needle) << 4);
+    }
+
+    return matches + countScalar(keys + i, count - i, key);
+}
+
+#endif /* KEYED_X86 */
+
+
+/***** STATIC FUNCTIONS *****/
+
+/* The kernels in use. Only setKeyedSearch() changes them, and on x86-64 it is
+ * called once before main() to pick the widest, so searches only read them */
+static KeyedSearch searchMode = KEYED_SEARCH_SCALAR;
+static FindKernel findKernel = &findScalar;
+static CountKernel countKernel = &countScalar;
+
+
+/**
+ * Check whether @p mode can be used in this build on this processor.
+ */
+static int searchSupported(KeyedSearch mode)
+{
+    switch (mode)
+    {
+        case KEYED_SEARCH_SCALAR:
+            return TRUE;
+#ifdef KEYED_X86
+        case KEYED_SEARCH_SSE2:
+            return TRUE;
+        case KEYED_SEARCH_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return FALSE;
+    }
+}
+
+
+#ifdef KEYED_X86
+/**
+ * Choose the widest search when the program is loaded, before any thread can
+ * search.
+ */
+__attribute__((constructor))
+static void initSearch(void)
+{
+    setKeyedSearch(KEYED_SEARCH_AUTO);
+}
+#endif
+
+
+/**
+ * Allocate an empty chunk and link it into @p list at the head or tail. A
+ * chunk at the tail fills from the front and one at the head from the back.
+ */
+static KeyedChunk *addChunk(KeyedList *list, int atTail)
+{
+    KeyedChunk *chunk = (KeyedChunk *) malloc(sizeof(KeyedChunk));
+    if (!chunk)
+        return NULL;
+
+    chunk->start = atTail ? 0 : KEYED_CHUNK_KEYS;
+    chunk->count = 0;
+    chunk->next = NULL;
+
+    if (!list->head)
+    {
+        list->head = chunk;
+        list->tail = chunk;
+    }
+    else if (atTail)
+    {
+        list->tail->next = chunk;
+        list->tail = chunk;
+    }
+    else
+    {
+        chunk->next = list->head;
+        list->head = chunk;
+    }
+
+    return chunk;
+}
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+KeyedList* createKeyedList()
+{
+    /* allocate memory for the list */
+    KeyedList *list = (KeyedList *) malloc(sizeof(KeyedList));
+
+    /* if no error in allocating, initialise list contents */
+    if (list)
+    {
+        list->head = NULL;
+        list->tail = NULL;
+        list->length = 0;
+    }
+
+    return list;
+}
+
+
+int setKeyedSearch(KeyedSearch mode)
+{
+    /* try the widest search first */
+    if (mode == KEYED_SEARCH_AUTO)
+    {
+        return setKeyedSearch(KEYED_SEARCH_AVX2)
+            || setKeyedSearch(KEYED_SEARCH_SSE2)
+            || setKeyedSearch(KEYED_SEARCH_SCALAR);
+    }
+
+    if (!searchSupported(mode))
+        return FALSE;
+
+#ifdef KEYED_X86
+    if (mode == KEYED_SEARCH_AVX2)
+    {
+        findKernel = &findAVX2;
+        countKernel = &countAVX2;
+    }
+    else if (mode == KEYED_SEARCH_SSE2)
+    {
+        findKernel = &findSSE2;
+        countKernel = &countSSE2;
+    }
+    else
+#endif
+    {
+        findKernel = &findScalar;
+        countKernel = &countScalar;
+    }
+
+    searchMode = mode;
+    return TRUE;
+}
+
+
+KeyedSearch getKeyedSearch(void)
+{
+    return searchMode;
+}
+
+
+void *reduceKeyedList(KeyedList *list, Reducer callback, void *seed)
+{
+    KeyedChunk *chunk;
+    unsigned int i;
+
+    if (!list)
+        return seed;
+
+    /* iterate over each element of each chunk */
+    for (chunk = list->head; chunk; chunk = chunk->next)
+        for (i = chunk->start; i < chunk->start + chunk->count; i++)
+            seed = callback(chunk->data[i], seed);
+
+    return seed;
+}
+
+
+int insertKeyedTop(KeyedList *list, DataPointer data)
+{
+    KeyedChunk *top;
+
+    /* if list or data is NULL return immediately */
+    if (!list || !data)
+        return FALSE;
+
+    /* start a new chunk if the first has no room in front */
+    top = list->head;
+    if (!top || !top->start)
+        top = addChunk(list, FALSE);
+    if (!top)
+        return FALSE;
+
+    top->start--;
+    top->keys[top->start] = *(int64_t *) data;
+    top->data[top->start] = data;
+    top->count++;
+    list->length++;
+
+    return TRUE;
+}
+
+
+int insertKeyedTail(KeyedList *list, DataPointer data)
+{
+    KeyedChunk *tail;
+
+    /* if list or data is NULL return immediately */
+    if (!list || !data)
+        return FALSE;
+
+    /* start a new chunk if the last has no room behind */
+    tail = list->tail;
+    if (!tail || tail->start + tail->count == KEYED_CHUNK_KEYS)
+        tail = addChunk(list, TRUE);
+    if (!tail)
+        return FALSE;
+
+    tail->keys[tail->start + tail->count] = *(int64_t *) data;
+    tail->data[tail->start + tail->count] = data;
+    tail->count++;
+    list->length++;
+
+    return TRUE;
+}
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+void destroyKeyedList(KeyedList *list)
+{
+    unsigned int i;
+
+    /* if list is not NULL */
+    if (list)
+    {
+        /* free each element then the chunk holding them */
+        while (list->head)
+        {
+            KeyedChunk *top = list->head;
+            list->head = top->next;
+            for (i = top->start; i < top->start + top->count; i++)
+                free(top->data[i]);
+            free(top);
+        }
+
+        /* free list struct */
+        free(list);
+    }
+}
+
+
+void removeKeyedTop(KeyedList *list)
+{
+    KeyedChunk *top;
+
+    /* if list is not NULL or empty */
+    if (list && list->head)
+    {
+        top = list->head;
+        free(top->data[top->start]);
+
+        top->start++;
+        top->count--;
+        list->length--;
+
+        /* drop the chunk once empty */
+        if (!top->count)
+        {
+            list->head = top->next;
+            if (!list->head)
+                list->tail = NULL;
+            free(top);
+        }
+    }
+}
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+unsigned long keyedListLength(KeyedList *list)
+{
+    return list ? list->length : 0;
+}
+
+
+DataPointer peekKeyedTop(KeyedList *list)
+{
+    return list && list->head ? list->head->data[list->head->start] : NULL;
+}
+
+
+DataPointer findKeyedElement(KeyedList *list, int64_t key)
+{
+    KeyedChunk *chunk;
+    unsigned int i;
+
+    if (!list)
+        return NULL;
+
+    /* the elements are only read once their key matches */
+    for (chunk = list->head; chunk; chunk = chunk->next)
+    {
+        i = findKernel(chunk->keys + chunk->start, chunk->count, key);
+        if (i < chunk->count)
+            return chunk->data[chunk->start + i];
+    }
+
+    return NULL;
+}
+
+
+unsigned long countKeyedMatching(KeyedList *list, int64_t key)
+{
+    KeyedChunk *chunk;
+    unsigned long matches = 0;
+
+    if (!list)
+        return 0;
+
+    for (chunk = list->head; chunk; chunk = chunk->next)
+        matches += countKernel(chunk->keys + chunk->start, chunk->count, key);
+
+    return matches;
+}
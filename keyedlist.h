@@ -0,0 +1,220 @@
+/**
+ * @file    keyedlist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Keyed list for elements that start with a 64-bit integer key. The
+ *          keys are copied into chunks apart from the elements, so a search
+ *          reads them in order and compares several per instruction.
+ */
+
+
+#ifndef KEYEDLIST_H
+#define KEYEDLIST_H
+
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The number of keys held by each chunk of a keyed list. The keys of a full
+ * chunk span `KEYED_CHUNK_KEYS / 8` cache lines of 64 bytes, so larger chunks
+ * follow fewer `next` pointers but waste more space when partly filled.
+ */
+#ifndef KEYED_CHUNK_KEYS
+    #define KEYED_CHUNK_KEYS 64
+#endif
+
+/**
+ * Define `KEYED_NO_SIMD` to only build the scalar search. Otherwise the SSE2
+ * and AVX2 searches are built on x86-64 with GCC or Clang, and the best one the
+ * processor supports is chosen at runtime.
+ */
+/*#define KEYED_NO_SIMD*/
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` representing a chunk of a keyed list. The `count` entries of
+ * `keys` and `data` from `start` are in use, and `keys[i]` is the key of
+ * `data[i]`. A chunk started at the top of the list fills from the back, so
+ * both ends of the list grow and shrink without moving any entries.
+ */
+typedef struct KeyedChunk {
+    struct KeyedChunk *next;
+    unsigned int start;
+    unsigned int count;
+    int64_t keys[KEYED_CHUNK_KEYS];
+    DataPointer data[KEYED_CHUNK_KEYS];
+} KeyedChunk;
+
+
+/**
+ * A `struct` representing a keyed list.
+ */
+typedef struct KeyedList {
+    KeyedChunk *head;
+    KeyedChunk *tail;
+    unsigned long length;
+} KeyedList;
+
+
+/**
+ * The ways of comparing keys. See setKeyedSearch().
+ */
+typedef enum KeyedSearch {
+    KEYED_SEARCH_AUTO,
+    KEYED_SEARCH_SCALAR,
+    KEYED_SEARCH_SSE2,
+    KEYED_SEARCH_AVX2
+} KeyedSearch;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+/* Each element must begin with an `int64_t` key, for example as the first
+ * member of a `struct`. The key is copied when the element is inserted, so
+ * changing it afterwards does not move the element or change searches. */
+
+/**
+ * @brief Create a new empty keyed list.
+ *
+ * @return A pointer to a new empty keyed list or `NULL` on error.
+ */
+KeyedList* createKeyedList();
+
+
+/**
+ * @brief Choose how keys are compared by every keyed list.
+ *
+ * `KEYED_SEARCH_AUTO` picks the widest search the processor supports, which is
+ * also chosen when the program is loaded. The searches only differ in speed.
+ *
+ * This function is not thread-safe: no other thread may be searching a keyed
+ * list while it is called. Searching from many threads at once is safe.
+ *
+ * @param mode The search to use.
+ * @return Positive integer if @p mode is supported by this build and processor,
+ *         zero otherwise, in which case the search is not changed.
+ */
+int setKeyedSearch(KeyedSearch mode);
+
+
+/**
+ * @brief Get the search used to compare keys.
+ *
+ * @return The search in use, never `KEYED_SEARCH_AUTO`.
+ */
+KeyedSearch getKeyedSearch(void);
+
+
+/**
+ * @brief Perform a reduce operation on a keyed list.
+ *
+ * Behaves the same as reduceList(), calling @p callback on each element in
+ * order.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each element in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceKeyedList(KeyedList *list, Reducer callback, void *seed);
+
+
+/**
+ * @brief Insert an element at the top of a keyed list.
+ *
+ * The element is added to the first chunk if it has space before its first
+ * element, otherwise a new chunk is started in front of it. Takes constant
+ * time.
+ *
+ * @param list The list to add to.
+ * @param data The element to insert, starting with its key.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertKeyedTop(KeyedList *list, DataPointer data);
+
+
+/**
+ * @brief Insert an element at the end of a keyed list.
+ *
+ * The element is added to the last chunk if it has space after its last
+ * element, otherwise a new chunk is started after it. Takes constant time.
+ *
+ * @param list The list to add to.
+ * @param data The element to insert, starting with its key.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertKeyedTail(KeyedList *list, DataPointer data);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete an entire keyed list.
+ *
+ * Frees all the memory associated with @p list, including each element.
+ *
+ * @param list The list to delete.
+ */
+void destroyKeyedList(KeyedList *list);
+
+
+/**
+ * @brief Delete the element at the top of a keyed list.
+ *
+ * If it exists, the first element is removed and `free()` is called on it.
+ * Takes constant time.
+ *
+ * @param list The list to remove from.
+ */
+void removeKeyedTop(KeyedList *list);
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+/**
+ * @brief Get the number of elements in a keyed list.
+ *
+ * @param list The list to determine the length of.
+ * @return The size of the supplied list.
+ */
+unsigned long keyedListLength(KeyedList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the first element of a keyed list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the first element, or `NULL` if empty.
+ */
+DataPointer peekKeyedTop(KeyedList *list);
+
+
+/**
+ * @brief Find the first element with a key.
+ *
+ * Only the chunks of keys are read until a match is found.
+ *
+ * @param list The list to search.
+ * @param key The key to find.
+ * @return A pointer to the first element with @p key, or `NULL` if there is
+ *         none.
+ */
+DataPointer findKeyedElement(KeyedList *list, int64_t key);
+
+
+/**
+ * @brief Count the elements with a key.
+ *
+ * @param list The list to search.
+ * @param key The key to count.
+ * @return The number of elements with @p key.
+ */
+unsigned long countKeyedMatching(KeyedList *list, int64_t key);
+
+
+#endif /* end of include guard: KEYEDLIST_H */
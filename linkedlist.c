@@ -6,119 +6,1816 @@
  *          For a more detailed explanation of the library see the README.
  */
 
+#include <string.h>
+#ifdef LL_STATS
+    #include <time.h>
+#endif
 #include "linkedlist.h"
+#include "listinternal.h"
+
+
+/* The number of nodes in a pool's first slab if none is given */
+#define POOL_DEFAULT_CAPACITY 64
+/* The largest number of nodes a pool will add in a single slab */
+#define POOL_MAX_GROWTH 65536
+/* The number of slots in a new hash index if the list is small */
+#define INDEX_MIN_CAPACITY 16
+/* The number of sorted runs sortList() keeps, enough for any list length */
+#define SORT_BINS (sizeof(unsigned long) * 8)
+
+#ifdef LL_STATS
+/**
+ * The statistics of every list freed so far.
+ */
+static ListStats retiredStats;
+#endif
+
+
+/**
+ * A type with the strictest alignment inline elements are expected to need.
+ */
+typedef union InlineAlign {
+    long l;
+    double d;
+    void *p;
+} InlineAlign;
+
+/* Round @p size up to a multiple of the inline element alignment */
+#define INLINE_ALIGN(size) \
+    (((size) + sizeof(InlineAlign) - 1) / sizeof(InlineAlign) * sizeof(InlineAlign))
+
+
+/**
+ * A `struct` representing a single block of nodes within a pool. The nodes
+ * follow immediately after this header in memory.
+ */
+typedef struct NodeSlab {
+    struct NodeSlab *next;
+    unsigned long capacity;
+    unsigned long unused;
+} NodeSlab;
+
+
+/**
+ * A `struct` representing the node pool of a list. The nodes of the newest slab
+ * are handed out in address order from `bump`, which has `remaining` nodes left.
+ * Nodes that have been released are chained together through their `next`
+ * pointers and reused first. A pool added to a list that already had nodes may
+ * also collect those individually allocated nodes, which `strays` records. The
+ * slabs come from the list's allocator.
+ */
+struct NodePool {
+    const ListAllocator *allocator;
+    ListNode *free;
+    NodeSlab *slabs;
+    char *bump;
+    unsigned long remaining;
+    unsigned long growth;
+    unsigned long nodeSize;
+    int strays;
+};
+
+
+/**
+ * A `struct` representing a slot within a hash index. Empty slots have a
+ * `NULL` node. The mixed hash of the node's data is kept so the index can grow
+ * without hashing every element again.
+ */
+typedef struct IndexEntry {
+    ListNode *node;
+    unsigned long hash;
+} IndexEntry;
+
+
+/**
+ * A `struct` representing the hash index of a list. It is an open addressed
+ * table with linear probing, kept at most half full.
+ */
+struct HashIndex {
+    HashFunc hash;
+    DifferenceFunc equal;
+    IndexEntry *entries;
+    unsigned long capacity;
+    unsigned long count;
+};
+
+
+/***** INTERNAL FUNCTIONS *****/
+/* These helpers keep the optional tail pointer, previous links and length in
+ * step with the node chain, so the public functions below do not need to know
+ * which of the conditional features are enabled. */
+
+/**
+ * Allocate @p size bytes of node memory from @p allocator, or `malloc()` if it
+ * is `NULL`.
+ */
+static void *allocBlock(const ListAllocator *allocator, unsigned long size)
+{
+    if (allocator)
+        return allocator->allocate(allocator->context, size);
+
+    return malloc(size);
+}
+
+
+/**
+ * Release @p block, which came from allocBlock() with the same @p allocator.
+ */
+static void freeBlock(const ListAllocator *allocator, void *block)
+{
+    if (!allocator)
+        free(block);
+    else if (allocator->release)
+        allocator->release(allocator->context, block);
+}
+
+
+/**
+ * Get the number of bytes taken by each node of @p list, including any inline
+ * element stored after it.
+ */
+static unsigned long nodeSize(LinkedList *list)
+{
+    if (list->elementSize)
+        return INLINE_ALIGN(sizeof(ListNode)) + INLINE_ALIGN(list->elementSize);
+
+    return sizeof(ListNode);
+}
+
+
+/**
+ * Get the first node stored in @p slab.
+ */
+static char *slabNodes(NodeSlab *slab)
+{
+    return (char *) slab + INLINE_ALIGN(sizeof(NodeSlab));
+}
+
+
+/**
+ * Allocate an empty pool for the nodes of @p list.
+ */
+static struct NodePool *createPool(LinkedList *list)
+{
+    struct NodePool *pool = (struct NodePool *) malloc(sizeof(struct NodePool));
+
+    if (pool)
+    {
+        pool->allocator = list->allocator;
+        pool->free = NULL;
+        pool->slabs = NULL;
+        pool->bump = NULL;
+        pool->remaining = 0;
+        pool->growth = POOL_DEFAULT_CAPACITY;
+        pool->nodeSize = nodeSize(list);
+        pool->strays = list->head != NULL;
+    }
+
+    return pool;
+}
+
+
+/**
+ * Put the nodes not yet handed out from the newest slab of @p pool on its free
+ * list.
+ */
+static void retireBump(struct NodePool *pool)
+{
+    /* push in reverse so nodes are handed out in address order */
+    while (pool->remaining)
+    {
+        ListNode *node;
+
+        pool->remaining--;
+        node = (ListNode *) (pool->bump + pool->remaining * pool->nodeSize);
+        node->next = pool->free;
+        pool->free = node;
+    }
+}
+
+
+/**
+ * Add a new slab of @p capacity nodes to @p pool and hand out nodes from it
+ * next. Returns zero if memory could not be allocated.
+ */
+static int growPool(struct NodePool *pool, unsigned long capacity)
+{
+    NodeSlab *slab;
+
+    slab = (NodeSlab *) allocBlock(pool->allocator,
+            INLINE_ALIGN(sizeof(NodeSlab)) + capacity * pool->nodeSize);
+    if (!slab)
+        return FALSE;
+
+    slab->capacity = capacity;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    /* the nodes are not touched until they are handed out */
+    retireBump(pool);
+    pool->bump = slabNodes(slab);
+    pool->remaining = capacity;
+
+    /* make each slab larger than the last, up to a limit */
+    if (capacity > pool->growth)
+        pool->growth = capacity;
+    if (pool->growth < POOL_MAX_GROWTH)
+        pool->growth *= 2;
+
+    return TRUE;
+}
+
+
+/**
+ * Spread the bits of a user supplied hash, so that simple hashes such as the
+ * value of an integer still use every slot of an index.
+ */
+static unsigned long mixHash(unsigned long hash)
+{
+    hash ^= hash >> 15;
+    hash *= 2246822519UL;
+    hash ^= hash >> 13;
+    hash *= 3266489917UL;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+
+/**
+ * Put @p node in a free slot of @p index, which must have room for it.
+ */
+static void placeEntry(struct HashIndex *index, ListNode *node, unsigned long hash)
+{
+    unsigned long mask = index->capacity - 1;
+    unsigned long slot = hash & mask;
+
+    while (index->entries[slot].node)
+        slot = (slot + 1) & mask;
+
+    index->entries[slot].node = node;
+    index->entries[slot].hash = hash;
+    index->count++;
+}
+
+
+/**
+ * Move the entries of @p index into a new table of @p capacity slots, which
+ * must be a power of two. Returns zero if memory could not be allocated.
+ */
+static int resizeIndex(struct HashIndex *index, unsigned long capacity)
+{
+    IndexEntry *old = index->entries;
+    unsigned long oldCapacity = index->capacity;
+    unsigned long i;
+
+    index->entries = (IndexEntry *) calloc(capacity, sizeof(IndexEntry));
+    if (!index->entries)
+    {
+        index->entries = old;
+        return FALSE;
+    }
+
+    index->capacity = capacity;
+    index->count = 0;
+    for (i = 0; i < oldCapacity; i++)
+    {
+        if (old[i].node)
+            placeEntry(index, old[i].node, old[i].hash);
+    }
+
+    free(old);
+    return TRUE;
+}
+
+
+/**
+ * Make sure the index of @p list, if it has one, can take @p count more
+ * entries. Returns zero if memory could not be allocated.
+ */
+static int reserveIndex(LinkedList *list, unsigned long count)
+{
+    struct HashIndex *index = list->index;
+    unsigned long capacity;
+
+    if (!index || (index->count + count) * 2 <= index->capacity)
+        return TRUE;
+
+    capacity = index->capacity;
+    while ((index->count + count) * 2 > capacity)
+        capacity *= 2;
+
+    return resizeIndex(index, capacity);
+}
+
+
+/**
+ * Add @p node to the index of @p list, if it has one. Room must have been made
+ * with reserveIndex().
+ */
+static void indexNode(LinkedList *list, ListNode *node)
+{
+    struct HashIndex *index = list->index;
+
+    if (index)
+        placeEntry(index, node, mixHash(index->hash(node->data)));
+}
+
+
+/**
+ * Remove @p node from the index of @p list, if it has one.
+ */
+static void unindexNode(LinkedList *list, ListNode *node)
+{
+    struct HashIndex *index = list->index;
+    unsigned long mask;
+    unsigned long slot;
+    unsigned long next;
+
+    if (!index)
+        return;
+
+    mask = index->capacity - 1;
+    slot = mixHash(index->hash(node->data)) & mask;
+    while (index->entries[slot].node != node)
+    {
+        /* the element's hash has changed since it was indexed, so the node
+         * may be anywhere in the table */
+        if (!index->entries[slot].node)
+        {
+            for (slot = 0; slot < index->capacity; slot++)
+            {
+                if (index->entries[slot].node == node)
+                    break;
+            }
+            if (slot == index->capacity)
+                return;
+            break;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    /* shift back any following entries that would no longer be reachable */
+    next = slot;
+    for (;;)
+    {
+        unsigned long home;
+
+        next = (next + 1) & mask;
+        if (!index->entries[next].node)
+            break;
+
+        /* an entry can move back if its home slot is not between the gap and
+         * where it is now */
+        home = index->entries[next].hash & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            index->entries[slot] = index->entries[next];
+            slot = next;
+        }
+    }
+
+    index->entries[slot].node = NULL;
+    index->count--;
+}
+
+
+/**
+ * Empty the index of @p list, if it has one, shrinking it to its smallest size.
+ */
+static void clearIndex(LinkedList *list)
+{
+    struct HashIndex *index = list->index;
+    IndexEntry *entries;
+
+    if (!index)
+        return;
+
+    entries = (IndexEntry *) calloc(INDEX_MIN_CAPACITY, sizeof(IndexEntry));
+    if (entries)
+    {
+        free(index->entries);
+        index->entries = entries;
+        index->capacity = INDEX_MIN_CAPACITY;
+    }
+    else
+        memset(index->entries, 0, index->capacity * sizeof(IndexEntry));
+
+    index->count = 0;
+}
+
+
+/**
+ * Index every node of @p list again, if it has an index, keeping its size. This
+ * is needed after the nodes have been moved.
+ */
+static void rebuildIndex(LinkedList *list)
+{
+    struct HashIndex *index = list->index;
+    ListNode *node;
+
+    if (!index)
+        return;
+
+    memset(index->entries, 0, index->capacity * sizeof(IndexEntry));
+    index->count = 0;
+    for (node = list->head; node; node = node->next)
+        indexNode(list, node);
+}
+
+
+/**
+ * Free the index of @p list, if it has one.
+ */
+static void destroyIndex(LinkedList *list)
+{
+    if (list->index)
+    {
+        free(list->index->entries);
+        free(list->index);
+        list->index = NULL;
+    }
+}
+
+
+/**
+ * Take the next node from the newest slab of @p pool, which must have one left.
+ */
+static ListNode *bumpNode(struct NodePool *pool)
+{
+    ListNode *node = (ListNode *) pool->bump;
+
+    pool->bump += pool->nodeSize;
+    pool->remaining--;
+
+    return node;
+}
+
+
+/**
+ * Prepare a newly allocated @p node for use in @p list.
+ */
+static ListNode *initNode(LinkedList *list, ListNode *node)
+{
+    /* inline elements live directly after the node */
+    if (node && list->elementSize)
+        node->data = (char *) node + INLINE_ALIGN(sizeof(ListNode));
+    if (node)
+        STAT_ADD(list, allocations, 1);
+
+    return node;
+}
+
+
+/**
+ * Allocate a node for @p list, from its pool if it has one.
+ */
+static ListNode *allocNode(LinkedList *list)
+{
+    struct NodePool *pool = list->pool;
+    ListNode *node;
+
+    /* make sure the node can be indexed once it is linked */
+    if (!reserveIndex(list, 1))
+        return NULL;
+
+    if (!pool)
+        return initNode(list, (ListNode *) allocBlock(list->allocator, nodeSize(list)));
+
+    /* reuse released nodes first */
+    if (pool->free)
+    {
+        node = pool->free;
+        pool->free = node->next;
+        return initNode(list, node);
+    }
+
+    /* add another slab if every node is in use */
+    if (!pool->remaining && !growPool(pool, pool->growth))
+        return NULL;
+
+    return initNode(list, bumpNode(pool));
+}
+
+
+/**
+ * Store @p data in a node from allocNode(), copying it in for inline lists.
+ */
+static void storeData(LinkedList *list, ListNode *node, DataPointer data)
+{
+    if (list->elementSize)
+        memcpy(node->data, data, list->elementSize);
+    else
+        node->data = data;
+}
+
+
+/**
+ * Free the data stored in @p node, if the list owns it.
+ */
+static void releaseData(LinkedList *list, ListNode *node)
+{
+    if (list->freeData)
+        list->freeData(node->data);
+}
+
+
+/**
+ * The default way a list frees its data. The standard `free()` can not be
+ * stored in the list directly when it is replaced by a macro.
+ */
+static void freeWithLibc(DataPointer data)
+{
+    free(data);
+}
+
+
+/**
+ * Release a node previously returned by allocNode(). The data is not freed.
+ */
+static void freeNode(LinkedList *list, ListNode *node)
+{
+    struct NodePool *pool = list->pool;
+
+    STAT_ADD(list, frees, 1);
+    if (pool)
+    {
+        node->next = pool->free;
+        pool->free = node;
+    }
+    else
+        freeBlock(list->allocator, node);
+}
+
+
+/**
+ * Find the slab of @p pool that contains @p node, or `NULL` if none does.
+ */
+static NodeSlab *findSlab(struct NodePool *pool, ListNode *node)
+{
+    NodeSlab *slab;
+
+    for (slab = pool->slabs; slab; slab = slab->next)
+    {
+        char *nodes = slabNodes(slab);
+        if ((char *) node >= nodes && (char *) node < nodes + slab->capacity * pool->nodeSize)
+            return slab;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Free every slab of @p pool, leaving it empty. Any nodes still in use are
+ * freed along with their slab.
+ */
+static void releaseSlabs(struct NodePool *pool)
+{
+    /* nodes allocated before the pool existed are not part of any slab */
+    if (pool->strays)
+    {
+        ListNode *node = pool->free;
+        while (node)
+        {
+            ListNode *next = node->next;
+            if (!findSlab(pool, node))
+                freeBlock(pool->allocator, node);
+            node = next;
+        }
+    }
+
+    while (pool->slabs)
+    {
+        NodeSlab *slab = pool->slabs;
+        pool->slabs = slab->next;
+        freeBlock(pool->allocator, slab);
+    }
+
+    pool->free = NULL;
+    pool->bump = NULL;
+    pool->remaining = 0;
+    pool->strays = FALSE;
+}
+
+
+/**
+ * Free @p pool and every slab within it.
+ */
+static void destroyPool(struct NodePool *pool)
+{
+    releaseSlabs(pool);
+    free(pool);
+}
+
+
+/**
+ * Whether every node of @p list can be released along with its pool's slabs,
+ * or needs no releasing at all, without visiting each node to free its data.
+ */
+static int dropsNodes(LinkedList *list)
+{
+    if (list->freeData)
+        return FALSE;
+    if (list->allocator && !list->allocator->release)
+        return TRUE;
+
+    return list->pool && !list->pool->strays;
+}
+
+
+/**
+ * Find the last node of a non-empty list.
+ */
+static ListNode *findTail(LinkedList *list)
+{
+#ifdef DOUBLE_ENDED
+    return list->tail;
+#else
+    ListNode *tail = list->head;
+
+    /* iterate through to the end */
+    while (tail->next)
+    {
+        tail = tail->next;
+        STAT_ADD(list, traversed, 1);
+    }
+
+    return tail;
+#endif
+}
+
+
+/**
+ * Find the node before @p node, or `NULL` if it is the head.
+ */
+static ListNode *findPrevious(LinkedList *list, ListNode *node)
+{
+#ifdef DOUBLY_LINKED
+    (void) list;
+    return node->prev;
+#else
+    ListNode *previous = NULL;
+    ListNode *current = list->head;
+
+    while (current != node)
+    {
+        previous = current;
+        current = current->next;
+        STAT_ADD(list, traversed, 1);
+    }
+
+    return previous;
+#endif
+}
+
+
+/**
+ * Link the chain of @p count nodes from @p first to @p last into the list after
+ * @p previous, or at the head if @p previous is `NULL`. The chain must already
+ * be linked internally.
+ */
+static void linkChain(LinkedList *list, ListNode *previous, ListNode *first,
+        ListNode *last, unsigned long count)
+{
+    ListNode **link = previous ? &previous->next : &list->head;
+    ListNode *node;
+
+    last->next = *link;
+    *link = first;
+
+    /* the finger only moves along if the chain went in before it */
+    if (list->finger)
+    {
+        if (!previous)
+            list->fingerIndex += count;
+        else if (previous != list->finger && last->next)
+            list->finger = NULL;
+    }
+
+    if (list->index)
+    {
+        for (node = first; node != last->next; node = node->next)
+            indexNode(list, node);
+    }
+
+#ifdef DOUBLY_LINKED
+    first->prev = previous;
+    if (last->next)
+        last->next->prev = last;
+#endif
+#ifdef DOUBLE_ENDED
+    if (!last->next)
+        list->tail = last;
+#endif
+#ifdef INSTANT_LENGTH
+    list->length += count;
+#endif
+    countLength(list, (long) count);
+}
+
+
+void linkNode(LinkedList *list, ListNode *previous, ListNode *node)
+{
+    linkChain(list, previous, node, node, 1);
+}
+
+
+/**
+ * Build a chain of nodes holding the @p count elements of @p items in order,
+ * taking every node from a single new slab. The list is given a pool if it does
+ * not have one. Returns the first node and sets @p last to the final node, or
+ * returns `NULL` if memory could not be allocated.
+ */
+static ListNode *allocChain(LinkedList *list, DataPointer *items,
+        unsigned long count, ListNode **last)
+{
+    ListNode *first = NULL;
+    ListNode *previous = NULL;
+    unsigned long i;
+
+    if (!reserveIndex(list, count))
+        return NULL;
+    if (!list->pool && !(list->pool = createPool(list)))
+        return NULL;
+
+    /* the new slab's nodes are handed out in order */
+    if (!growPool(list->pool, count))
+        return NULL;
+
+    for (i = 0; i < count; i++)
+    {
+        ListNode *node = initNode(list, bumpNode(list->pool));
+        storeData(list, node, items[i]);
+
+        if (previous)
+            previous->next = node;
+        else
+            first = node;
+#ifdef DOUBLY_LINKED
+        node->prev = previous;
+#endif
+        previous = node;
+    }
+
+    *last = previous;
+    return first;
+}
+
+
+void unlinkNode(LinkedList *list, ListNode *previous, ListNode *node)
+{
+    unindexNode(list, node);
+
+    /* keep the finger on a node still in the list, at the right index */
+    if (list->finger == node)
+        list->finger = node->next;
+    else if (list->finger)
+    {
+        if (!previous)
+            list->fingerIndex--;
+        else if (previous != list->finger && node->next)
+            list->finger = NULL;
+    }
+
+    if (previous)
+        previous->next = node->next;
+    else
+        list->head = node->next;
+
+#ifdef DOUBLY_LINKED
+    if (node->next)
+        node->next->prev = previous;
+#endif
+#ifdef DOUBLE_ENDED
+    if (!node->next)
+        list->tail = previous;
+#endif
+#ifdef INSTANT_LENGTH
+    list->length--;
+#endif
+    countLength(list, -1);
+}
+
+
+/**
+ * Find the first node of @p list whose data is equal to @p needle, using the
+ * hash index when @p diff is `NULL` or the index's own equality function. Sets
+ * @p previous, unless it is `NULL`, to the node before it. Returns `NULL` if
+ * there is no such node or no way to compare.
+ */
+static ListNode *findNode(LinkedList *list, DataPointer needle,
+        DifferenceFunc diff, ListNode **previous)
+{
+    struct HashIndex *index = list->index;
+    ListNode *current;
+    ListNode *last = NULL;
+
+    if (index && (!diff || diff == index->equal))
+    {
+        unsigned long hash = mixHash(index->hash(needle));
+        unsigned long mask = index->capacity - 1;
+        unsigned long slot;
+
+        for (slot = hash & mask; index->entries[slot].node; slot = (slot + 1) & mask)
+        {
+            current = index->entries[slot].node;
+            if (index->entries[slot].hash == hash && index->equal(current->data, needle) == 0)
+            {
+                if (previous)
+                    *previous = findPrevious(list, current);
+                return current;
+            }
+        }
+
+        return NULL;
+    }
+
+    if (!diff)
+        diff = list->difference;
+    if (!diff)
+        return NULL;
+
+    /* search the list in order, tracking the node before */
+    for (current = list->head; current; current = current->next)
+    {
+        if (diff(current->data, needle) == 0)
+        {
+            if (previous)
+                *previous = last;
+            return current;
+        }
+        last = current;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Restore the previous links and tail pointer of @p list after its chain of
+ * `next` pointers has been rearranged. The finger is forgotten.
+ */
+static void fixLinks(LinkedList *list)
+{
+#if defined(DOUBLY_LINKED) || defined(DOUBLE_ENDED)
+    ListNode *previous = NULL;
+    ListNode *current;
+
+    for (current = list->head; current; current = current->next)
+    {
+#ifdef DOUBLY_LINKED
+        current->prev = previous;
+#endif
+        previous = current;
+    }
+#ifdef DOUBLE_ENDED
+    list->tail = previous;
+#endif
+#endif
+
+    list->finger = NULL;
+}
+
+
+/**
+ * Convert the possibly negative @p index into a position counted from the head
+ * of @p list, where @p extra positions past the last element are also valid.
+ * Returns zero if the index is out of bounds.
+ */
+static int resolveIndex(LinkedList *list, long index, unsigned long extra,
+        unsigned long *position)
+{
+    unsigned long length;
+    unsigned long back;
+
+    if (index >= 0)
+    {
+        *position = (unsigned long) index;
+        return TRUE;
+    }
+
+    /* count back from the end, without overflowing on the most negative index */
+    length = listLength(list) + extra;
+    back = (unsigned long) -(index + 1) + 1;
+    if (back > length)
+        return FALSE;
+
+    *position = length - back;
+    return TRUE;
+}
+
+
+/**
+ * Find the node at @p position in @p list, starting from the finger when it is
+ * closer than the head, and leave the finger there. Returns `NULL` if the list
+ * is not that long.
+ */
+static ListNode *nodeAt(LinkedList *list, unsigned long position)
+{
+    ListNode *node = list->head;
+    unsigned long current = 0;
+
+    if (list->finger && list->fingerIndex <= position)
+    {
+        node = list->finger;
+        current = list->fingerIndex;
+    }
+#ifdef DOUBLY_LINKED
+    else if (list->finger && list->fingerIndex - position < position)
+    {
+        /* step back from the finger */
+        node = list->finger;
+        for (current = list->fingerIndex; current > position; current--)
+        {
+            node = node->prev;
+            STAT_ADD(list, traversed, 1);
+        }
+    }
+#endif
+#if defined(DOUBLE_ENDED) && defined(INSTANT_LENGTH)
+    if (list->length && position == list->length - 1)
+    {
+        node = list->tail;
+        current = position;
+    }
+#endif
+
+    while (node && current < position)
+    {
+        node = node->next;
+        current++;
+        STAT_ADD(list, traversed, 1);
+    }
+
+    if (node)
+    {
+        list->finger = node;
+        list->fingerIndex = position;
+    }
+
+    return node;
+}
+
+
+/**
+ * Merge the sorted chains @p left and @p right into one, taking from @p left
+ * first when elements are equal.
+ */
+static ListNode *mergeChains(ListNode *left, ListNode *right, DifferenceFunc diff)
+{
+    ListNode *head = NULL;
+    ListNode **link = &head;
+
+    while (left && right)
+    {
+        if (diff(left->data, right->data) <= 0)
+        {
+            *link = left;
+            left = left->next;
+        }
+        else
+        {
+            *link = right;
+            right = right->next;
+        }
+
+        link = &(*link)->next;
+    }
+
+    /* append whatever remains of either chain */
+    *link = left ? left : right;
+
+    return head;
+}
+
+
+/**
+ * Give the pool of @p other, and any nodes it holds, to @p list so the nodes of
+ * @p other can be moved into @p list.
+ */
+static void adoptPool(LinkedList *list, LinkedList *other)
+{
+    struct NodePool *pool = list->pool;
+    struct NodePool *from = other->pool;
+    NodeSlab *slab;
+    ListNode *node;
+
+    if (!from)
+    {
+        /* the nodes of other were allocated individually */
+        if (pool && other->head)
+            pool->strays = TRUE;
+        return;
+    }
+
+    other->pool = NULL;
+    if (!pool)
+    {
+        /* take over the pool, along with the nodes already in list */
+        if (list->head)
+            from->strays = TRUE;
+        list->pool = from;
+        return;
+    }
+
+    /* append the slabs and unused nodes of one pool to the other */
+    retireBump(from);
+    if (from->slabs)
+    {
+        for (slab = from->slabs; slab->next; slab = slab->next)
+            ;
+        slab->next = pool->slabs;
+        pool->slabs = from->slabs;
+    }
+    if (from->free)
+    {
+        for (node = from->free; node->next; node = node->next)
+            ;
+        node->next = pool->free;
+        pool->free = from->free;
+    }
+
+    if (from->strays)
+        pool->strays = TRUE;
+    if (from->growth > pool->growth)
+        pool->growth = from->growth;
+
+    free(from);
+}
+
+
+/**
+ * Free @p list along with any nodes still in it, without freeing their data.
+ */
+static void freeList(LinkedList *list)
+{
+    /* nothing needs to be found any more */
+    destroyIndex(list);
+
+    while (list->head)
+    {
+        ListNode *top = list->head;
+        unlinkNode(list, NULL, top);
+        freeNode(list, top);
+    }
+
+    /* hand back whole slabs rather than individual nodes */
+    if (list->pool)
+        destroyPool(list->pool);
+
+#ifdef LL_STATS
+    retireStats(list);
+#endif
+
+    free(list);
+}
+
+
+#ifdef LL_STATS
+void retireStats(LinkedList *list)
+{
+    /* keep the counts of the list in the totals */
+    retiredStats.allocations += list->stats.allocations;
+    retiredStats.frees += list->stats.frees;
+    retiredStats.traversed += list->stats.traversed;
+    if (list->stats.peakLength > retiredStats.peakLength)
+        retiredStats.peakLength = list->stats.peakLength;
+}
+
+
+void countDestroyed(clock_t start)
+{
+    retiredStats.destroyed++;
+    retiredStats.destroySeconds += (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+#endif
+
+
+void initList(LinkedList *list)
+{
+    list->head = NULL;
+    list->pool = NULL;
+    list->elementSize = 0;
+    list->difference = NULL;
+    list->index = NULL;
+    list->freeData = &freeWithLibc;
+    list->allocator = NULL;
+    list->finger = NULL;
+    list->fingerIndex = 0;
+#ifdef DOUBLE_ENDED
+    list->tail = NULL;
+#endif
+#ifdef INSTANT_LENGTH
+    list->length = 0;
+#else
+    list->knownLength = 0;
+#endif
+#ifdef LL_STATS
+    memset(&list->stats, 0, sizeof(ListStats));
+#endif
+}
+
+
+void countLength(LinkedList *list, long change)
+{
+#ifndef INSTANT_LENGTH
+    /* an unknown length stays unknown until it is counted */
+    if (list->knownLength && change < 0)
+        list->knownLength -= (unsigned long) -change;
+    else if (list->knownLength)
+        list->knownLength += (unsigned long) change;
+#endif
+#ifdef LL_STATS
+    if (change < 0)
+        list->stats.length -= (unsigned long) -change;
+    else
+        list->stats.length += (unsigned long) change;
+
+    if (list->stats.length > list->stats.peakLength)
+        list->stats.peakLength = list->stats.length;
+#endif
+#if defined(INSTANT_LENGTH) && !defined(LL_STATS)
+    (void) list;
+    (void) change;
+#endif
+}
 
 
 LinkedList* createList()
 {
-    /* allocate memory for the list */
-    LinkedList *list = (LinkedList *) malloc(sizeof(LinkedList));
+    /* allocate memory for the list */
+    LinkedList *list = (LinkedList *) malloc(sizeof(LinkedList));
+
+    /* if no error in allocating, initialise list contents */
+    if (list)
+        initList(list);
+
+    return list;
+}
+
+
+/**
+ * Give @p list a pool with a first slab of @p initialCapacity nodes, or the
+ * default if zero. Frees the list and returns `NULL` on error.
+ */
+static LinkedList *addPool(LinkedList *list, unsigned long initialCapacity)
+{
+    if (!list)
+        return NULL;
+
+    list->pool = createPool(list);
+    if (!list->pool)
+    {
+        free(list);
+        return NULL;
+    }
+
+    /* allocate the first slab up front */
+    if (!growPool(list->pool, initialCapacity ? initialCapacity : POOL_DEFAULT_CAPACITY))
+    {
+        destroyPool(list->pool);
+        free(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+
+LinkedList* createListWithPool(unsigned long initialCapacity)
+{
+    return addPool(createList(), initialCapacity);
+}
+
+
+LinkedList* createListWithArena(unsigned long elementSize, unsigned long chunkSize)
+{
+    LinkedList *list = createList();
+
+    /* the list never frees data, so nodes only need freeing with their slab */
+    if (list)
+    {
+        list->elementSize = elementSize;
+        list->freeData = NULL;
+    }
+
+    return addPool(list, chunkSize);
+}
+
+
+LinkedList* createListWithAllocator(const ListAllocator *allocator, FreeDataFunc freeData)
+{
+    LinkedList *list = createList();
+
+    if (list)
+    {
+        list->allocator = allocator;
+        list->freeData = freeData;
+    }
+
+    return list;
+}
+
+
+LinkedList* createInlineList(unsigned long elementSize)
+{
+    LinkedList *list;
+
+    if (!elementSize)
+        return NULL;
+
+    list = createList();
+    if (list)
+    {
+        list->elementSize = elementSize;
+        /* the data is freed with the node */
+        list->freeData = NULL;
+    }
+
+    return list;
+}
+
+
+int attachHashIndex(LinkedList *list, HashFunc hash, DifferenceFunc equal)
+{
+    struct HashIndex *index;
+    unsigned long capacity = INDEX_MIN_CAPACITY;
+    unsigned long length;
+    ListNode *node;
+
+    if (!list || !hash || !equal)
+        return FALSE;
+
+    length = listLength(list);
+    while (capacity < length * 2)
+        capacity *= 2;
+
+    index = (struct HashIndex *) malloc(sizeof(struct HashIndex));
+    if (!index)
+        return FALSE;
+    index->entries = (IndexEntry *) calloc(capacity, sizeof(IndexEntry));
+    if (!index->entries)
+    {
+        free(index);
+        return FALSE;
+    }
+    index->hash = hash;
+    index->equal = equal;
+    index->capacity = capacity;
+    index->count = 0;
+
+    /* replace any existing index */
+    destroyIndex(list);
+    list->index = index;
+    for (node = list->head; node; node = node->next)
+        indexNode(list, node);
+
+    return TRUE;
+}
+
+
+void detachHashIndex(LinkedList *list)
+{
+    if (list)
+        destroyIndex(list);
+}
+
+
+unsigned long shrinkPool(LinkedList *list)
+{
+    struct NodePool *pool;
+    NodeSlab *slab;
+    NodeSlab *bumpSlab;
+    NodeSlab **link;
+    ListNode *node;
+    ListNode **freeLink;
+    unsigned long released = 0;
+
+    if (!list || !list->pool)
+        return 0;
+    pool = list->pool;
+
+    /* count the unused nodes within each slab, releasing any strays */
+    for (slab = pool->slabs; slab; slab = slab->next)
+        slab->unused = 0;
+    bumpSlab = pool->remaining ? findSlab(pool, (ListNode *) pool->bump) : NULL;
+    if (bumpSlab)
+        bumpSlab->unused = pool->remaining;
+    freeLink = &pool->free;
+    while (*freeLink)
+    {
+        node = *freeLink;
+        slab = findSlab(pool, node);
+        if (slab)
+        {
+            slab->unused++;
+            freeLink = &node->next;
+        }
+        else
+        {
+            *freeLink = node->next;
+            released++;
+            freeBlock(pool->allocator, node);
+        }
+    }
+
+    /* drop nodes belonging to completely unused slabs from the free list */
+    freeLink = &pool->free;
+    while (*freeLink)
+    {
+        slab = findSlab(pool, *freeLink);
+        if (slab->unused == slab->capacity)
+            *freeLink = (*freeLink)->next;
+        else
+            freeLink = &(*freeLink)->next;
+    }
+
+    /* then free those slabs */
+    link = &pool->slabs;
+    while (*link)
+    {
+        slab = *link;
+        if (slab->unused == slab->capacity)
+        {
+            *link = slab->next;
+            released += slab->capacity;
+            if (slab == bumpSlab)
+            {
+                pool->bump = NULL;
+                pool->remaining = 0;
+            }
+            freeBlock(pool->allocator, slab);
+        }
+        else
+            link = &slab->next;
+    }
+
+    return released;
+}
+
+
+int compactList(LinkedList *list)
+{
+    struct NodePool *old;
+    struct NodePool *pool;
+    ListNode *current;
+    ListNode **link;
+
+    if (!list)
+        return FALSE;
+    if (!list->head)
+        return TRUE;
+
+    /* a single slab holds every node, so it is filled in traversal order */
+    pool = createPool(list);
+    if (!pool || !growPool(pool, listLength(list)))
+    {
+        free(pool);
+        return FALSE;
+    }
+    pool->strays = FALSE;
+
+    old = list->pool;
+    current = list->head;
+    link = &list->head;
+    while (current)
+    {
+        ListNode *next = current->next;
+        ListNode *copy = initNode(list, bumpNode(pool));
+
+        storeData(list, copy, current->data);
+        *link = copy;
+        link = &copy->next;
+
+        /* the old node is finished with once its data is copied */
+        freeNode(list, current);
+        current = next;
+    }
+    *link = NULL;
+
+    list->pool = pool;
+    if (old)
+        destroyPool(old);
+    fixLinks(list);
+    rebuildIndex(list);
+
+    return TRUE;
+}
+
+
+void *reduceList(LinkedList *list, Reducer callback, void *seed)
+{
+    /* if the list is not empty */
+    if (list && list->head)
+    {
+        ListNode *current = list->head;
+
+        /* iterate over the list calling the reducer function */
+        do
+        {
+            seed = callback(current->data, seed);
+            current = current->next;
+        } while (current);
+    }
+
+    return seed;
+}
+
+
+int insertTop(LinkedList *list, DataPointer data)
+{
+    ListNode *top;
+
+    /* if list is NULL return immediately */
+    if(!list)
+        return FALSE;
+
+    /* allocate memory for the node */
+    top = allocNode(list);
+    /* if memory could not be allocated return immediately */
+    if(!top)
+        return FALSE;
+
+    /* insert the value */
+    storeData(list, top, data);
+
+    /* add the node to the start */
+    linkNode(list, NULL, top);
+
+    return TRUE;
+}
+
+
+int insertTail(LinkedList *list, DataPointer data)
+{
+    if(list)
+    {
+        /* allocate memory for the node */
+        ListNode *new = allocNode(list);
+        /* if memory could not be allocated return immediately */
+        if(!new)
+            return FALSE;
+
+        storeData(list, new, data);
+
+        /* add the node after the current end, or as the head if empty */
+        linkNode(list, list->head ? findTail(list) : NULL, new);
+
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+int insertArrayTop(LinkedList *list, DataPointer *items, unsigned long count)
+{
+    ListNode *first;
+    ListNode *last;
+
+    if (!list || (count && !items))
+        return FALSE;
+    if (!count)
+        return TRUE;
+
+    first = allocChain(list, items, count, &last);
+    if (!first)
+        return FALSE;
+
+    linkChain(list, NULL, first, last, count);
+
+    return TRUE;
+}
+
+
+int insertArrayTail(LinkedList *list, DataPointer *items, unsigned long count)
+{
+    ListNode *first;
+    ListNode *last;
+
+    if (!list || (count && !items))
+        return FALSE;
+    if (!count)
+        return TRUE;
+
+    first = allocChain(list, items, count, &last);
+    if (!first)
+        return FALSE;
+
+    /* add the chain after the current end, or as the whole list if empty */
+    linkChain(list, list->head ? findTail(list) : NULL, first, last, count);
+
+    return TRUE;
+}
+
+
+int insertIndex(LinkedList *list, DataPointer value, long index)
+{
+    unsigned long position;
+    ListNode *previous = NULL;
+    ListNode *node;
 
-    /* if no error in allocating, initialise list contents */
-    if (list)
-        list->head = NULL;
+    /* one past the last element is a valid place to insert */
+    if (!list || !resolveIndex(list, index, 1, &position))
+        return FALSE;
 
-    return list;
+    if (position)
+    {
+        previous = nodeAt(list, position - 1);
+        if (!previous)
+            return FALSE;
+    }
+
+    node = allocNode(list);
+    if (!node)
+        return FALSE;
+
+    storeData(list, node, value);
+    linkNode(list, previous, node);
+
+    /* the next index is likely to be nearby */
+    list->finger = node;
+    list->fingerIndex = position;
+
+    return TRUE;
 }
 
 
-void *reduceList(LinkedList *list, Reducer callback, void *seed)
+void destroyList(LinkedList *list)
 {
-    /* if the list is not empty */
-    if (list && list->head)
+#ifdef LL_STATS
+    clock_t start = clock();
+#endif
+
+    /* if list is not NULL or empty */
+    if (list)
     {
-        ListNode *current = list->head;
+        /* nothing needs to be found any more */
+        destroyIndex(list);
 
-        /* iterate over the list calling the reducer function */
-        do
+        if (dropsNodes(list))
         {
-            seed = callback(current->data, seed);
-            current = current->next;
-        } while (current);
-    }
+            /* the nodes go with the pool's slabs */
+            STAT_ADD(list, frees, list->stats.length);
+            list->head = NULL;
+        }
+        else if (list->head)
+        {
+            /* iterate through list removing the head each time */
+            do
+                removeTop(list);
+            while (list->head);
+        }
 
-    return seed;
+        /* free the pool and list struct */
+        freeList(list);
+
+#ifdef LL_STATS
+        countDestroyed(start);
+#endif
+    }
 }
 
 
-int insertTop(LinkedList *list, DataPointer data)
+int insertSorted(LinkedList *list, DataPointer value)
 {
-    ListNode *top;
+    ListNode *previous = NULL;
+    ListNode *node;
 
-    /* if list is NULL return immediately */
-    if(!list)
+    if (!list)
         return FALSE;
 
-    /* allocate memory for the node */
-    top = (ListNode *) malloc(sizeof(ListNode));
-    /* if memory could not be allocated return immediately */
-    if(!top)
+    /* without an ordering fall back to the top */
+    if (!list->difference)
+        return insertTop(list, value) ? -1 : FALSE;
+
+    node = allocNode(list);
+    if (!node)
         return FALSE;
+    storeData(list, node, value);
 
-    /* insert the value */
-    top->data = data;
+#ifdef DOUBLE_ENDED
+    /* appending in order does not need to search */
+    if (list->head && list->difference(list->tail->data, node->data) <= 0)
+        previous = list->tail;
+    else
+#endif
+    {
+        /* find the last node not greater than the value */
+        ListNode *current = list->head;
+        while (current && list->difference(current->data, node->data) <= 0)
+        {
+            previous = current;
+            current = current->next;
+        }
+    }
 
-    /* add the node to the start */
-    top->next = list->head;
-    list->head = top;
+    linkNode(list, previous, node);
 
     return TRUE;
 }
 
 
-int insertTail(LinkedList *list, DataPointer data)
+void sortList(LinkedList *list, DifferenceFunc diff)
 {
-    if(list)
+    /* bins[i] holds a sorted run of 2^i nodes, or is empty */
+    ListNode *bins[SORT_BINS];
+    ListNode *remaining;
+    ListNode *run;
+    unsigned long used = 0;
+    unsigned long i;
+
+    if (!list || !list->head)
+        return;
+    if (!diff)
+        diff = list->difference;
+    if (!diff)
+        return;
+
+    /* add the nodes one at a time, merging equal sized runs like carrying in
+     * binary addition. Recently merged nodes are merged again soon after, which
+     * keeps them in the cache */
+    remaining = list->head;
+    while (remaining)
     {
-        /* allocate memory for the node */
-        ListNode *new = (ListNode *) malloc(sizeof(ListNode));
-        /* if memory could not be allocated return immediately */
-        if(!new)
+        run = remaining;
+        remaining = remaining->next;
+        run->next = NULL;
+
+        /* older runs go on the left to keep the sort stable */
+        for (i = 0; i < used && bins[i]; i++)
+        {
+            run = mergeChains(bins[i], run, diff);
+            bins[i] = NULL;
+        }
+
+        if (i == used)
+            used++;
+        bins[i] = run;
+    }
+
+    /* merge the remaining runs, smallest and newest first */
+    run = NULL;
+    for (i = 0; i < used; i++)
+    {
+        if (bins[i])
+            run = mergeChains(bins[i], run, diff);
+    }
+
+    list->head = run;
+    fixLinks(list);
+}
+
+
+int mergeLists(LinkedList *list, LinkedList *other, DifferenceFunc diff)
+{
+    if (!list || !other || list == other || list->elementSize != other->elementSize ||
+            list->allocator != other->allocator || list->freeData != other->freeData)
+        return FALSE;
+    if (!diff)
+        diff = list->difference;
+    if (!diff)
+        return FALSE;
+
+    /* index the nodes of other before anything is moved */
+    if (list->index)
+    {
+        ListNode *node;
+
+        if (!reserveIndex(list, listLength(other)))
             return FALSE;
+        for (node = other->head; node; node = node->next)
+            indexNode(list, node);
+    }
 
-        new->data = data;
-        new->next = NULL;
+    adoptPool(list, other);
 
-        /* if list is not empty */
-        if(list->head)
-        {
-            ListNode *tail = list->head;
+    list->head = mergeChains(list->head, other->head, diff);
+    fixLinks(list);
+#ifdef INSTANT_LENGTH
+    list->length += other->length;
+    other->length = 0;
+#endif
+#ifdef LL_STATS
+    countLength(list, (long) other->stats.length);
+    other->stats.length = 0;
+#endif
+#ifndef INSTANT_LENGTH
+    /* the length of other is not known without counting it */
+    list->knownLength = 0;
+#endif
+
+    /* the nodes now belong to list */
+    other->head = NULL;
+    freeList(other);
 
-            /* iterate through to the end */
-            while(tail && tail->next)
-                tail = tail->next;
+    return TRUE;
+}
 
-            tail->next = new;
 
-            return TRUE;
-        }
-        else
+ArrayList* list2Array(LinkedList *list)
+{
+    ArrayList *array;
+    unsigned long length;
+    unsigned long offset;
+    unsigned long i;
+    ListNode *current;
+
+    if (!list)
+        return NULL;
+
+    /* the pointers follow the struct, and any inline elements follow them */
+    length = listLength(list);
+    offset = INLINE_ALIGN(sizeof(ArrayList) + length * sizeof(DataPointer));
+    array = (ArrayList *) malloc(offset + length * list->elementSize);
+    if (!array)
+        return NULL;
+
+    array->elements = length ? (DataPointer *) (array + 1) : NULL;
+    array->length = length;
+    array->elementSize = list->elementSize;
+    array->freeData = list->freeData;
+
+    for (current = list->head, i = 0; current; current = current->next, i++)
+    {
+        if (list->elementSize)
         {
-            list->head = new;
-            return TRUE;
+            array->elements[i] = (char *) array + offset + i * list->elementSize;
+            memcpy(array->elements[i], current->data, list->elementSize);
         }
+        else
+            array->elements[i] = current->data;
     }
 
-    return FALSE;
+    /* the array now owns the data, if the list did */
+    freeList(list);
+
+    return array;
 }
 
 
-void destroyList(LinkedList *list)
+void destroyArray(ArrayList *array, FreeDataFunc freeData)
 {
-    /* if list is not NULL or empty */
-    if (list)
+    unsigned long i;
+
+    if (!array)
+        return;
+
+    if (!freeData)
+        freeData = array->freeData;
+
+    if (!array->elementSize && freeData)
     {
-        if (list->head)
-        {
-            /* iterate through list removing the head each time */
-            do
-                removeTop(list);
-            while (list->head);
-        }
+        for (i = 0; i < array->length; i++)
+            freeData(array->elements[i]);
+    }
 
-        /* free list struct */
-        free(list);
+    free(array);
+}
+
+
+void resetList(LinkedList *list)
+{
+    struct HashIndex *index;
+
+    if (!list)
+        return;
+
+    /* the index is emptied all at once afterwards */
+    index = list->index;
+    list->index = NULL;
+
+    if (dropsNodes(list))
+    {
+        STAT_ADD(list, frees, list->stats.length);
+        list->head = NULL;
+        list->finger = NULL;
+#ifdef DOUBLE_ENDED
+        list->tail = NULL;
+#endif
+#ifdef INSTANT_LENGTH
+        list->length = 0;
+#else
+        list->knownLength = 0;
+#endif
+#ifdef LL_STATS
+        list->stats.length = 0;
+#endif
+    }
+    else
+    {
+        while (list->head)
+            removeTop(list);
     }
+
+    /* every node is unused, so every slab can go */
+    if (list->pool)
+        releaseSlabs(list->pool);
+
+    list->index = index;
+    clearIndex(list);
 }
 
 
@@ -129,13 +1826,32 @@ void removeTop(LinkedList *list)
     {
         /* re-arrange the list */
         ListNode *top = list->head;
-        list->head = top->next;
+        unlinkNode(list, NULL, top);
 
         /* free the data that was top */
-        free(top->data);
+        releaseData(list, top);
         /* free the node itself */
-        free(top);
+        freeNode(list, top);
+    }
+}
+
+
+DataPointer popTop(LinkedList *list)
+{
+    DataPointer data = NULL;
+
+    /* if list is not NULL or empty, and the data outlives the node */
+    if (list && list->head && !list->elementSize)
+    {
+        ListNode *top = list->head;
+        unlinkNode(list, NULL, top);
+
+        /* keep the data but free the node */
+        data = top->data;
+        freeNode(list, top);
     }
+
+    return data;
 }
 
 
@@ -144,57 +1860,126 @@ void removeTail(LinkedList *list)
     /* if list is not NULL or empty */
     if (list && list->head)
     {
+#ifdef DOUBLY_LINKED
+        ListNode *tail = findTail(list);
+        ListNode *previous = tail->prev;
+#else
+        ListNode *previous = NULL;
         ListNode *tail = list->head;
-        ListNode *previous = tail;
 
-        /* if list has only one node */
-        if (list->head->next)
+        /* find the tail and the node before it in a single walk */
+        while (tail->next)
         {
-            /* iterate through to the end */
-            while(tail && tail->next)
-            {
-                previous = tail;
-                tail = tail->next;
-            }
+            previous = tail;
+            tail = tail->next;
+            STAT_ADD(list, traversed, 1);
+        }
+#endif
+
+        unlinkNode(list, previous, tail);
 
+        releaseData(list, tail);
+        freeNode(list, tail);
+    }
+}
 
-            previous->next = NULL;
 
-            free(tail->data);
-            free(tail);
-        }
-        else /* list length > 1 */
-        {
-            free(list->head->data);
-            free(list->head);
-            list->head = NULL;
-        }
+int removeIndex(LinkedList *list, long index)
+{
+    unsigned long position;
+    ListNode *previous = NULL;
+    ListNode *node;
+
+    if (!list || !resolveIndex(list, index, 0, &position))
+        return FALSE;
+
+    if (position)
+    {
+        previous = nodeAt(list, position - 1);
+        node = previous ? previous->next : NULL;
     }
+    else
+        node = list->head;
+    if (!node)
+        return FALSE;
+
+    /* the finger stays on the node before, or moves to the node after */
+    unlinkNode(list, previous, node);
+
+    releaseData(list, node);
+    freeNode(list, node);
+
+    return TRUE;
+}
+
+
+int removeElement(LinkedList *list, DataPointer value, DifferenceFunc diff)
+{
+    ListNode *previous;
+    ListNode *node;
+
+    if (!list)
+        return FALSE;
+
+    node = findNode(list, value, diff, &previous);
+    if (!node)
+        return FALSE;
+
+    unlinkNode(list, previous, node);
+    releaseData(list, node);
+    freeNode(list, node);
+
+    return TRUE;
 }
 
 
 unsigned long listLength(LinkedList *list)
 {
+#ifdef INSTANT_LENGTH
+    /* the length is kept up to date on every insertion and removal */
+    if (list)
+        return list->length;
+#else
     /* if list is not NULL or empty */
     if(list && list->head)
     {
         unsigned long length = 1;
-
         ListNode *current = list->head;
+
+        /* the length is kept up to date once it has been counted */
+        if (list->knownLength)
+            return list->knownLength;
+
         while (current->next)
         {
             /* move to the next node and increment the length */
             current = current->next;
             length++;
+            STAT_ADD(list, traversed, 1);
         }
 
+        list->knownLength = length;
         return length;
     }
+#endif
 
     return 0;
 }
 
 
+DataPointer findElement(LinkedList *list, DataPointer needle, DifferenceFunc diff)
+{
+    ListNode *node;
+
+    if (!list)
+        return NULL;
+
+    node = findNode(list, needle, diff, NULL);
+
+    return node ? node->data : NULL;
+}
+
+
 DataPointer peekTop(LinkedList *list)
 {
     /* if list is not NULL or empty */
@@ -209,13 +1994,147 @@ DataPointer peekTail(LinkedList *list)
 {
     /* if list is not NULL or empty */
     if(list && list->head)
+        return findTail(list)->data;
+
+    return NULL;
+}
+
+
+DataPointer peekIndex(LinkedList *list, long index)
+{
+    unsigned long position;
+    ListNode *node;
+
+    if (!list || !resolveIndex(list, index, 0, &position))
+        return NULL;
+
+    node = nodeAt(list, position);
+    return node ? node->data : NULL;
+}
+
+
+int getListStats(LinkedList *list, ListStats *stats)
+{
+#ifdef LL_STATS
+    *stats = list ? list->stats : retiredStats;
+    return TRUE;
+#else
+    (void) list;
+    memset(stats, 0, sizeof(ListStats));
+    return FALSE;
+#endif
+}
+
+
+void resetListStats(LinkedList *list)
+{
+#ifdef LL_STATS
+    ListStats *stats = list ? &list->stats : &retiredStats;
+    unsigned long length = stats->length;
+
+    memset(stats, 0, sizeof(ListStats));
+    stats->length = length;
+    stats->peakLength = length;
+#else
+    (void) list;
+#endif
+}
+
+
+void initCursor(ListCursor *cursor, LinkedList *list)
+{
+    cursor->list = list;
+    cursor->previous = NULL;
+    cursor->current = list ? list->head : NULL;
+}
+
+
+int cursorNext(ListCursor *cursor)
+{
+    if (cursor->current)
     {
-        ListNode *tail = list->head;
-        /* iterate through to the end */
-        while(tail && tail->next)
-            tail = tail->next;
-        return tail->data;
+        cursor->previous = cursor->current;
+        cursor->current = cursor->current->next;
     }
 
-    return NULL;
+    return cursor->current != NULL;
+}
+
+
+DataPointer cursorGet(ListCursor *cursor)
+{
+    return cursor->current ? cursor->current->data : NULL;
+}
+
+
+int cursorInsertAfter(ListCursor *cursor, DataPointer data)
+{
+    ListNode *node;
+
+    if (!cursor->current)
+        return FALSE;
+
+    node = allocNode(cursor->list);
+    if (!node)
+        return FALSE;
+
+    storeData(cursor->list, node, data);
+    linkNode(cursor->list, cursor->current, node);
+
+    return TRUE;
+}
+
+
+int cursorInsertBefore(ListCursor *cursor, DataPointer data)
+{
+    ListNode *node;
+
+    if (!cursor->list)
+        return FALSE;
+
+    node = allocNode(cursor->list);
+    if (!node)
+        return FALSE;
+
+    storeData(cursor->list, node, data);
+    linkNode(cursor->list, cursor->previous, node);
+
+    /* the cursor stays on the same element, which now follows the new one */
+    cursor->previous = node;
+
+    return TRUE;
+}
+
+
+void cursorRemoveCurrent(ListCursor *cursor)
+{
+    ListNode *node = cursor->current;
+
+    if (node)
+    {
+        cursor->current = node->next;
+        unlinkNode(cursor->list, cursor->previous, node);
+
+        releaseData(cursor->list, node);
+        freeNode(cursor->list, node);
+    }
+}
+
+
+DataPointer cursorUnlinkCurrent(ListCursor *cursor)
+{
+    ListNode *node = cursor->current;
+    DataPointer data = NULL;
+
+    /* the data must outlive the node */
+    if (node && !cursor->list->elementSize)
+    {
+        cursor->current = node->next;
+        unlinkNode(cursor->list, cursor->previous, node);
+
+        data = node->data;
+        freeNode(cursor->list, node);
+    }
+
+    return data;
 }
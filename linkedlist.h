@@ -38,25 +38,27 @@
  * `struct`, as opposed to being calculated by traversing the list.
  */
 /*#define INSTANT_LENGTH*/
-/*#ifdef INSTANT_LENGTH
-    #error "Instant length not yet supported"
-#endif*/
 
 /**
- * This enables a double ended linked list.
+ * This enables a double ended linked list. A pointer to the last node is kept
+ * in the list `struct` so the tail can be reached without traversing the list.
  */
 /*#define DOUBLE_ENDED*/
-/*#ifdef DOUBLE_ENDED
-    #error "Double ended not yet supported"
-#endif*/
 
 /**
- * This enables a doubly linked linked list.
+ * This enables a doubly linked linked list. Each node keeps a pointer to the
+ * node before it, so a node can be unlinked without searching for its
+ * predecessor. Combined with `DOUBLE_ENDED` this makes removeTail() constant
+ * time.
  */
 /*#define DOUBLY_LINKED*/
-/*#ifdef DOUBLY_LINKED
-    #error "Doubly linked not yet supported"
-#endif*/
+
+/**
+ * This enables per-list statistics, such as the number of nodes allocated and
+ * the number of nodes traversed to find the tail or length. See getListStats().
+ * The counters are not compiled in unless this is defined.
+ */
+/*#define LL_STATS*/
 
 /**
  * This enables logging information to be printed to `stderr`.
@@ -90,7 +92,7 @@ typedef void* DataPointer;
  * data when deleting an element or the entire list. eg: freeing the contents of
  * a dynamically allocated `struct`.
  */
-/*typedef void (* FreeDataFunc)(LinkedListData);*/
+typedef void (* FreeDataFunc)(DataPointer);
 
 
 /**
@@ -103,7 +105,17 @@ typedef void* DataPointer;
  * argument is less than the second, and > 0 if the first is larger than the
  * second.
  */
-/*typedef int (* DifferenceFunc)(LinkedListData, LinkedListData);*/
+typedef int (* DifferenceFunc)(DataPointer, DataPointer);
+
+
+/**
+ * @brief A function pointer type that hashes a value of the type stored in the
+ *        list.
+ *
+ * The user can define a function of this type to build a hash index on a list
+ * (see attachHashIndex()). Values that compare equal must have the same hash.
+ */
+typedef unsigned long (* HashFunc)(DataPointer);
 
 
 /**
@@ -138,26 +150,122 @@ typedef void *(* Reducer)(DataPointer, void *);
 typedef struct ListNode {
     DataPointer data;
     struct ListNode *next;
+#ifdef DOUBLY_LINKED
+    struct ListNode *prev;
+#endif
 } ListNode;
 
 
 /**
- * A `struct` representing an array of the same data stored in a list.
+ * A `struct` representing an array of the same data stored in a list. The
+ * element pointers, and any inline elements they point to, are stored in the
+ * same block of memory as the `struct`. `freeData` is taken from the list, and
+ * is `NULL` if the array does not own its data.
  */
-/*typedef struct ArrayList {
-    DataPointer element;
+typedef struct ArrayList {
+    DataPointer *elements;
     unsigned long length;
-} ArrayList;*/
+    unsigned long elementSize;
+    FreeDataFunc freeData;
+} ArrayList;
+
+
+/**
+ * A `struct` describing where the nodes of a list get their memory from. See
+ * createListWithAllocator().
+ *
+ * `allocate` is called with `context` and the number of bytes needed, and
+ * returns suitably aligned memory or `NULL` on error. `release` is called with
+ * `context` and a block from `allocate` once the list is finished with it. It
+ * may be `NULL` if the memory is reclaimed all at once, such as for an arena,
+ * in which case destroying or resetting a list that does not own its data does
+ * not visit each node.
+ */
+typedef struct ListAllocator {
+    void *(* allocate)(void *context, unsigned long size);
+    void (* release)(void *context, void *block);
+    void *context;
+} ListAllocator;
+
+
+/**
+ * A `struct` holding the statistics gathered for a list when `LL_STATS` is
+ * defined. `traversed` counts the nodes stepped over to find the tail, the node
+ * before another, the length or an index, which is where the O(n) costs of a
+ * configuration show up. `destroyed` and `destroySeconds` are only set in the
+ * totals for lists that have been freed.
+ */
+typedef struct ListStats {
+    unsigned long allocations;
+    unsigned long frees;
+    unsigned long traversed;
+    unsigned long length;
+    unsigned long peakLength;
+    unsigned long destroyed;
+    double destroySeconds;
+} ListStats;
+
+
+/**
+ * An opaque pool of nodes owned by a list. See createListWithPool().
+ */
+struct NodePool;
+
+
+/**
+ * An opaque hash index on the elements of a list. See attachHashIndex().
+ */
+struct HashIndex;
 
 
 /**
- * A `struct` representing a single linked list.
+ * A `struct` representing a single linked list. The `difference` field may be
+ * set by the user to order the list (see insertSorted() and sortList()). The
+ * `freeData` field is called on the data of each removed element; it defaults
+ * to the standard `free()`, and may be replaced or set to `NULL` if the list
+ * does not own its data. Nodes come from `allocator`, or from `malloc()` when it
+ * is `NULL`. The `finger` field caches the node last found by index,
+ * at `fingerIndex`, so nearby index operations do not start from the head; it
+ * is `NULL` when unknown. Without `INSTANT_LENGTH`, `knownLength` caches the
+ * length once it has been counted, and is zero when unknown.
  */
 typedef struct LinkedList {
     ListNode *head;
+    struct NodePool *pool;
+    unsigned long elementSize;
+    DifferenceFunc difference;
+    struct HashIndex *index;
+    FreeDataFunc freeData;
+    const ListAllocator *allocator;
+    ListNode *finger;
+    unsigned long fingerIndex;
+#ifdef DOUBLE_ENDED
+    ListNode *tail;
+#endif
+#ifdef INSTANT_LENGTH
+    unsigned long length;
+#else
+    unsigned long knownLength;
+#endif
+#ifdef LL_STATS
+    ListStats stats;
+#endif
 } LinkedList;
 
 
+/**
+ * A `struct` representing a position within a list, used to visit and edit the
+ * elements in a single pass. `current` is the node at the cursor, or `NULL` once
+ * the cursor has moved past the end, and `previous` is the node before it. See
+ * initCursor().
+ */
+typedef struct ListCursor {
+    LinkedList *list;
+    ListNode *previous;
+    ListNode *current;
+} ListCursor;
+
+
 /***** INSERTION & MODIFICATION FUNCTIONS *****/
 /* The functions below provide methods of creating a new list and inserting
  * elements at specific positions. A converter function is also provided that
@@ -173,6 +281,133 @@ typedef struct LinkedList {
 LinkedList* createList();
 
 
+/**
+ * @brief Create a new empty linked list that allocates nodes from a pool.
+ *
+ * Nodes for the list are carved out of large slabs instead of being allocated
+ * one at a time. Removed nodes are kept on a free list and reused by later
+ * insertions, and destroyList() releases whole slabs. Further slabs are added
+ * as needed, each larger than the last.
+ *
+ * @param initialCapacity The number of nodes in the first slab. If zero a
+ *                        default capacity is used.
+ * @return A pointer to a new empty linked list or `NULL` on error.
+ */
+LinkedList* createListWithPool(unsigned long initialCapacity);
+
+
+/**
+ * @brief Create a new empty linked list that stores its elements inline.
+ *
+ * Each node carries a copy of its element directly after the node itself, so
+ * an element costs a single allocation and sits next to its link. insertTop()
+ * and insertTail() copy @p elementSize bytes from the supplied pointer, which
+ * remains owned by the caller. The peek functions return a pointer into the
+ * node that is valid until the element is removed. Removing elements does not
+ * call `free()` on the data.
+ *
+ * @param elementSize The size in bytes of every element in the list.
+ * @return A pointer to a new empty linked list or `NULL` on error.
+ */
+LinkedList* createInlineList(unsigned long elementSize);
+
+
+/**
+ * @brief Create a new empty linked list that allocates from an arena.
+ *
+ * Nodes are handed out in order from large chunks, as for createListWithPool().
+ * If @p elementSize is not zero the elements are copied into the nodes as for
+ * createInlineList(), otherwise the list stores the pointers it is given
+ * without taking ownership of them. As the list never frees any data,
+ * destroyList() and resetList() release the whole list in time proportional to
+ * the number of chunks rather than the number of elements.
+ *
+ * @param elementSize The size in bytes of every element, or zero to store
+ *                    pointers.
+ * @param chunkSize The number of nodes in the first chunk. If zero a default
+ *                  is used. Each further chunk is larger than the last.
+ * @return A pointer to a new empty linked list or `NULL` on error.
+ */
+LinkedList* createListWithArena(unsigned long elementSize, unsigned long chunkSize);
+
+
+/**
+ * @brief Create a new empty linked list with its own allocator and data owner.
+ *
+ * Every node of the list, including the slabs of any pool it is later given,
+ * is allocated and released through @p allocator instead of `malloc()` and
+ * `free()`. The list `struct` itself still comes from `malloc()`. The data of
+ * each removed element is passed to @p freeData.
+ *
+ * @param allocator The allocator for the nodes, which must outlive the list, or
+ *                  `NULL` to use `malloc()`.
+ * @param freeData The function called on the data of each removed element, or
+ *                 `NULL` if the list does not own its data.
+ * @return A pointer to a new empty linked list or `NULL` on error.
+ */
+LinkedList* createListWithAllocator(const ListAllocator *allocator, FreeDataFunc freeData);
+
+
+/**
+ * @brief Add a hash index to a list.
+ *
+ * The index maps the elements of @p list to their nodes, so findElement() and
+ * removeElement() take expected constant time when they compare with
+ * @p equal. Every insertion and removal keeps the index up to date, and the
+ * order of the list is unaffected. Removal is only constant time when
+ * `DOUBLY_LINKED` is defined, as otherwise the node before must be searched
+ * for. Any existing index is replaced. An element changed after insertion in
+ * a way that changes its hash is not found by its new value, and removing it
+ * scans the whole index.
+ *
+ * @param list The list to index. Its current elements are indexed straight
+ *             away.
+ * @param hash The function used to hash each element.
+ * @param equal The function used to compare elements for equality. It only
+ *              needs to return zero for equal elements.
+ * @return Positive integer if the index was added, zero otherwise.
+ */
+int attachHashIndex(LinkedList *list, HashFunc hash, DifferenceFunc equal);
+
+
+/**
+ * @brief Remove and free the hash index of a list, if it has one.
+ *
+ * @param list The list whose index should be removed.
+ */
+void detachHashIndex(LinkedList *list);
+
+
+/**
+ * @brief Release unused memory held by a list's node pool.
+ *
+ * Frees every slab in the pool of @p list whose nodes are all unused. This is
+ * useful after removing a large number of elements. Lists without a pool are
+ * left unmodified.
+ *
+ * @param list The list whose pool should be shrunk.
+ * @return The number of nodes released.
+ */
+unsigned long shrinkPool(LinkedList *list);
+
+
+/**
+ * @brief Move the nodes of a list next to each other in traversal order.
+ *
+ * After many insertions and removals the nodes of a list can be spread across
+ * the heap, making every traversal slow. This copies the nodes into a single
+ * new block of memory, in the order they are linked, and frees the old ones.
+ * Elements keep their order and `DataPointer` values, except that the elements
+ * of a list from createInlineList() are copied along with their nodes. The list
+ * uses a node pool afterwards, even if it did not before. If an error occurs,
+ * the list is left unmodified.
+ *
+ * @param list The list to compact.
+ * @return Positive integer if the list was compacted, zero otherwise.
+ */
+int compactList(LinkedList *list);
+
+
 /**
  * @brief Convert a linked list into an array.
  *
@@ -183,15 +418,18 @@ LinkedList* createList();
  * otherwise an `ArrayList` is returned containing a pointer to the contiguous
  * data and it's length.
  *
+ * The array is a single allocation. For lists created with createInlineList()
+ * the elements are copied into the same block, after the pointers to them. The
+ * array keeps the list's `freeData`, so it owns the data only if the list did.
+ *
  * TODO: export in sorted order
- * TODO: this needs more thinking/designing... ie single 'chunk' of memory, how to allocate -> lists alloc func won't work, array of pointers to list elements?
  *
  * @param list The list to convert, containing the data to include in the
  *             array.
  * @return A pointer to a new `ArrayList` structure containing the elements and
  *         the length.
  */
-/*ArrayList* list2Array(LinkedList *list);*/
+ArrayList* list2Array(LinkedList *list);
 
 
 /**
@@ -227,7 +465,9 @@ int insertTop(LinkedList *list, DataPointer data);
 /**
  * @brief Insert an element at the end of a list.
  *
- * Similar to insertTop(), but will add the element to the end of @p list.
+ * Similar to insertTop(), but will add the element to the end of @p list. This
+ * is constant time when `DOUBLE_ENDED` is defined, otherwise the list is
+ * traversed to find the end.
  *
  * @param list The list to add to.
  * @param data The data to insert into the list.
@@ -236,12 +476,50 @@ int insertTop(LinkedList *list, DataPointer data);
 int insertTail(LinkedList *list, DataPointer data);
 
 
+/**
+ * @brief Insert an array of elements at the top of a list.
+ *
+ * The nodes for all @p count elements are allocated in a single block and
+ * linked together before being added to @p list in one step, so the first
+ * element of @p items becomes the top of the list and their order is kept.
+ * The list takes ownership of each element as for insertTop(), but not of the
+ * array itself. Lists without a pool are given one to hold the block. If an
+ * error occurs the list is left unmodified.
+ *
+ * @param list The list to add to.
+ * @param items The elements to insert, in order.
+ * @param count The number of elements in @p items.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertArrayTop(LinkedList *list, DataPointer *items, unsigned long count);
+
+
+/**
+ * @brief Insert an array of elements at the end of a list.
+ *
+ * Similar to insertArrayTop(), but adds the elements after the end of
+ * @p list. The end is only found once, no matter how many elements are added.
+ *
+ * @param list The list to add to.
+ * @param items The elements to insert, in order.
+ * @param count The number of elements in @p items.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertArrayTail(LinkedList *list, DataPointer *items, unsigned long count);
+
+
 /**
  * @brief Insert a value into a list at a given index.
  *
  * This expects @p value to be a valid pre-allocated pointer as no checks are
  * performed. After excecution, @p value will be at @p index within the list.
- * Note that negative indexing is supported.
+ * Note that negative indexing is supported, so an index of -1 inserts at the
+ * end.
+ *
+ * The search starts from the element last found by index when that is closer
+ * than the head, so inserting at the same or increasing indexes takes amortised
+ * constant time. Negative indexes need the length of the list, which is counted
+ * once and then kept up to date, so they cost the same after the first.
  *
  * @param list The list to add to.
  * @param value The data to insert into the list.
@@ -249,7 +527,7 @@ int insertTail(LinkedList *list, DataPointer data);
  * @return Positive integer for successful insertion, zero otherwise. (eg.
  *         index out of bounds)
  */
-/*int insertIndex(LinkedList *list, LinkedListData value, long index);*/
+int insertIndex(LinkedList *list, DataPointer value, long index);
 
 
 /**
@@ -257,14 +535,16 @@ int insertTail(LinkedList *list, DataPointer data);
  *
  * Using the defined difference function field in @p list, inserts @p value in
  * sorted order into the list. If the field is `NULL`, @p value will be inserted
- * at the top of the list and a negative integer returned.
+ * at the top of the list and a negative integer returned. Equal elements keep
+ * the order they were inserted in. When `DOUBLE_ENDED` is defined, values that
+ * belong at the end are inserted in constant time.
  *
  * @param  list  The list to add to.
  * @param  value The data to insert into the list.
  * @return Positive integer for successful insertion, negative if no sort
  *         function was used, and zero otherwise.
  */
-/*int insertSorted(LinkedList *list, LinkedListData value);*/
+int insertSorted(LinkedList *list, DataPointer value);
 
 
 /**
@@ -274,10 +554,34 @@ int insertTail(LinkedList *list, DataPointer data);
  * @p list, or another difference function passed in to @p compare. Use this
  * parameter to override the existing difference function.
  *
+ * This is a bottom-up merge sort that relinks the existing nodes, so it takes
+ * O(n log n) time and allocates no memory. The sort is stable. If neither
+ * difference function is given the list is left unmodified.
+ *
  * @param  list    The list to sort.
  * @param  diff The overriding compare function to use to determine ordering.
  */
-/*void sortList(LinkedList *list, DifferenceFunc diff);*/
+void sortList(LinkedList *list, DifferenceFunc diff);
+
+
+/**
+ * @brief Merge two sorted lists into one.
+ *
+ * Moves every element of @p other into @p list in linear time, keeping the
+ * result sorted. Both lists must already be sorted by the same difference
+ * function, which is either @p diff or, if `NULL`, the field in @p list. Equal
+ * elements from @p list come before those from @p other. The nodes are
+ * relinked rather than copied, and @p other is freed.
+ *
+ * @param list The list to merge into.
+ * @param other The list to merge from. Both lists must store the same kind of
+ *              element, ie. both inline with the same size or neither, and use
+ *              the same allocator and `freeData` function.
+ * @param diff The overriding compare function to use to determine ordering.
+ * @return Positive integer for a successful merge, zero otherwise, in which
+ *         case neither list is modified.
+ */
+int mergeLists(LinkedList *list, LinkedList *other, DifferenceFunc diff);
 
 
 /***** REMOVAL & DELETION FUNCTIONS *****/
@@ -288,43 +592,75 @@ int insertTail(LinkedList *list, DataPointer data);
 * @brief Delete an entire list.
 *
 * Frees all the memory associated with @p list. This includes every node and
-* each node's associated data.
+* each node's associated data. Lists created with createListWithArena() are
+* freed without visiting each node.
 *
 * @param list The list to delete.
 */
 void destroyList(LinkedList *list);
 
 
+/**
+ * @brief Remove every element from a list.
+ *
+ * Empties @p list as destroyList() would, but leaves the list itself ready for
+ * reuse. The memory held by its pool is released and any hash index is kept,
+ * but emptied.
+ *
+ * @param list The list to empty.
+ */
+void resetList(LinkedList *list);
+
+
 /**
  * @brief Delete an array converted from a list.
  *
  * Frees the contents of @p array. Delegates freeing to @p freeData to ensure
- * `structs` are properly deallocated. If @p freeData is `NULL` it is freed
- * internally.
+ * `structs` are properly deallocated. If @p freeData is `NULL` the `freeData`
+ * of the converted list is used instead, and the data is not freed if that was
+ * `NULL` too. Inline elements are freed with the array itself.
  *
  * @param array The array to delete.
  * @param freeData The user defined callback to free the data stored in the
- *                 list.
+ *                 list, or `NULL` to use the list's.
  */
-/*int destroyArray(ArrayList *array, FreeDataFunc freeData);*/
+void destroyArray(ArrayList *array, FreeDataFunc freeData);
 
 
 /**
  * @brief Delete the element at the top of a list.
  *
  * If it exists, the top element in @p list is removed. This function will also
- * call the standard implementation of `free()` on the data within the the node.
+ * call the list's `freeData` function, by default the standard implementation
+ * of `free()`, on the data within the the node.
  *
  * @param list The list to remove from.
  */
 void removeTop(LinkedList *list);
 
 
+/**
+ * @brief Remove the element at the top of a list and return it.
+ *
+ * If it exists, the top element in @p list is removed. Unlike removeTop(), the
+ * data within the node is not freed and the caller becomes responsible for it.
+ * Lists created with createInlineList() are left unmodified, as their data is
+ * freed with the node; use peekTop() and removeTop() instead.
+ *
+ * @param list The list to remove from.
+ * @return A pointer to the removed element, or `NULL` if empty.
+ */
+DataPointer popTop(LinkedList *list);
+
+
 /**
  * @brief Delete the element at the end of a list.
  *
  * If it exists, the last element in @p list is removed. This function will also
- * call the standard implementation of `free()` on the data within the the node.
+ * call the list's `freeData` function, by default the standard implementation
+ * of `free()`, on the data within the the node.
+ * This is constant time when both `DOUBLE_ENDED` and `DOUBLY_LINKED` are
+ * defined.
  *
  * @param list The list to remove from.
  */
@@ -334,15 +670,15 @@ void removeTail(LinkedList *list);
 /**
  * @brief Delete the element at a given index within a list.
  *
- * If it exists, the element at @p index is removed from the list. Delegates to
- * the `free` field of @p list to ensure all contents of the node are freed. If
- * this field. Negative indexing is supported.
+ * If it exists, the element at @p index is removed from the list and its data
+ * freed as for removeTop(). Negative indexing is supported. Like insertIndex(),
+ * removing at the same or nearby indexes takes amortised constant time.
  *
  * @param list The list to remove from.
  * @param index The index to remove (starting from 0).
  * @return Positive integer for successful removal, zero otherwise.
  */
-/*int removeIndex(LinkedList *list, long index);*/
+int removeIndex(LinkedList *list, long index);
 
 
 /**
@@ -351,15 +687,19 @@ void removeTail(LinkedList *list);
  * Use this to remove an element from @p list that matches @p value. This
  * delegates the comparison to @p diff, or if `NULL` defaults to the difference
  * function pointer stored in @p list. Use this to override the comparison (eg.
- * to loosen the constraints).
+ * to loosen the constraints). The data of the removed node is freed as for
+ * removeTop().
+ *
+ * If @p list has a hash index and @p diff is `NULL` or the index's equality
+ * function, the element is found through the index in expected constant time.
+ * Otherwise the first matching element in the list is removed.
  *
- * @param  list    The list to remove from.
- * @param  element The compared element to find and remove.
- * @param  compare The overriding comparison function to use.
+ * @param  list  The list to remove from.
+ * @param  value The compared element to find and remove.
+ * @param  diff  The overriding comparison function to use.
  * @return Positive integer for successful removal, zero otherwise.
  */
-/*int removeElement(LinkedList *list, LinkedListData value,
-        DifferenceFunc diff);*/
+int removeElement(LinkedList *list, DataPointer value, DifferenceFunc diff);
 
 
 /***** FINDING & SEARCHING FUNCTIONS *****/
@@ -370,7 +710,10 @@ void removeTail(LinkedList *list);
 /**
  * @brief Calculate the length of a list.
  *
- * Calculates the length of @p list.
+ * Calculates the length of @p list. This traverses the list unless
+ * `INSTANT_LENGTH` is defined, in which case the stored length is returned.
+ * Otherwise the counted length is kept up to date until another list is merged
+ * into it, so only the first call traverses it.
  * TODO: document list length limitation
  *
  * @param list The list to determine the length of.
@@ -390,13 +733,16 @@ unsigned long listLength(LinkedList *list);
  * inserting. Returns a pointer to the first found element or `NULL` if one is
  * not found.
  *
+ * If @p list has a hash index and @p diff is `NULL` or the index's equality
+ * function, the index is used instead of traversing the list. Where several
+ * elements are equal, any one of them may be returned.
+ *
  * @param list The list to search through.
  * @param needle The element to search for.
  * @param diff Overriding comparison function to use.
  * @return A pointer to the found element, or `NULL` if not found.
  */
-/*LinkedListData findElement(LinkedList *list, LinkedListData needle,
-        DifferenceFunc diff);*/
+DataPointer findElement(LinkedList *list, DataPointer needle, DifferenceFunc diff);
 
 
 /**
@@ -427,12 +773,128 @@ DataPointer peekTail(LinkedList *list);
  * @brief Retrieves, but does not remove, the element at a given index of a
  *        list.
  *
- * Negative indexing is supported.
+ * Negative indexing is supported. The search starts from the element last
+ * found by index when that is closer than the head, so sequential and nearby
+ * indexes take amortised constant time. When `DOUBLY_LINKED` is defined the
+ * search may also step backwards.
  *
  * @param list The list to retrieve from.
+ * @param index The index of the element (starting at 0).
  * @return A pointer to the element, or `NULL` if out of bounds.
  */
-/*LinkedListData peekIndex(LinkedList *list, long index);*/
+DataPointer peekIndex(LinkedList *list, long index);
+
+
+/***** STATISTICS FUNCTIONS *****/
+
+/**
+ * @brief Get the statistics gathered for a list.
+ *
+ * When @p list is `NULL` the totals for every list freed so far are given
+ * instead, including the time spent in destroyList(). The totals are shared by
+ * all threads and are not updated atomically.
+ *
+ * @param list The list to get the statistics of, or `NULL` for the totals.
+ * @param stats Set to the statistics, or all zero if `LL_STATS` is not defined.
+ * @return Positive integer if statistics are gathered in this build, zero
+ *         otherwise.
+ */
+int getListStats(LinkedList *list, ListStats *stats);
+
+
+/**
+ * @brief Reset the statistics of a list to zero.
+ *
+ * The current length is kept, and becomes the peak length.
+ *
+ * @param list The list to reset, or `NULL` to reset the totals.
+ */
+void resetListStats(LinkedList *list);
+
+
+/***** CURSOR FUNCTIONS *****/
+/* A cursor remembers its place in a list, so each of the functions below takes
+ * constant time. A cursor is only valid while the list is changed through it;
+ * any other insertion or removal may leave it pointing at a freed node. */
+
+/**
+ * @brief Place a cursor on the first element of a list.
+ *
+ * @param cursor The cursor to initialise. It may be on the stack.
+ * @param list The list to traverse.
+ */
+void initCursor(ListCursor *cursor, LinkedList *list);
+
+
+/**
+ * @brief Move a cursor to the next element.
+ *
+ * A cursor past the end of the list stays there.
+ *
+ * @param cursor The cursor to move.
+ * @return Positive integer if the cursor is on an element, zero if it has moved
+ *         past the end.
+ */
+int cursorNext(ListCursor *cursor);
+
+
+/**
+ * @brief Retrieves, but does not remove, the element at a cursor.
+ *
+ * @param cursor The cursor to retrieve from.
+ * @return A pointer to the element, or `NULL` if the cursor is past the end.
+ */
+DataPointer cursorGet(ListCursor *cursor);
+
+
+/**
+ * @brief Insert an element after the one at a cursor.
+ *
+ * The cursor does not move, so the new element is the next one visited.
+ *
+ * @param cursor The cursor to insert after.
+ * @param data The data to insert into the list.
+ * @return Positive integer for successful insertion, zero otherwise,
+ *         including if the cursor is past the end.
+ */
+int cursorInsertAfter(ListCursor *cursor, DataPointer data);
+
+
+/**
+ * @brief Insert an element before the one at a cursor.
+ *
+ * The cursor stays on the same element. A cursor past the end inserts at the
+ * end of the list.
+ *
+ * @param cursor The cursor to insert before.
+ * @param data The data to insert into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int cursorInsertBefore(ListCursor *cursor, DataPointer data);
+
+
+/**
+ * @brief Delete the element at a cursor.
+ *
+ * The element is removed and its data freed as for removeTop(). The cursor
+ * moves on to the next element.
+ *
+ * @param cursor The cursor to remove at.
+ */
+void cursorRemoveCurrent(ListCursor *cursor);
+
+
+/**
+ * @brief Remove the element at a cursor without freeing it.
+ *
+ * Behaves the same as cursorRemoveCurrent(), but the data is returned instead
+ * of freed, as for popTop(). Elements of a list from createInlineList() live in
+ * their node, so they can not be unlinked.
+ *
+ * @param cursor The cursor to remove at.
+ * @return A pointer to the unlinked element, or `NULL` if none was unlinked.
+ */
+DataPointer cursorUnlinkCurrent(ListCursor *cursor);
 
 
  #endif /* end of include guard: LINKEDLIST_H */
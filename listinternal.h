@@ -0,0 +1,97 @@
+/**
+ * @file    listinternal.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Internal functions shared by the modules built on a LinkedList.
+ *          Not part of the public interface.
+ */
+
+
+#ifndef LISTINTERNAL_H
+#define LISTINTERNAL_H
+
+
+#ifdef LL_STATS
+    #include <time.h>
+#endif
+#include "linkedlist.h"
+
+
+/* Add @p amount to a statistics counter of @p list, if they are gathered */
+#ifdef LL_STATS
+    #define STAT_ADD(list, counter, amount) ((list)->stats.counter += (amount))
+#else
+    #define STAT_ADD(list, counter, amount) ((void) 0)
+#endif
+
+
+/**
+ * @brief Initialise every field of a list as for a new empty list.
+ *
+ * Used by createList() and by lists that embed a LinkedList, so a new field
+ * only needs setting in one place.
+ *
+ * @param list The list to initialise.
+ */
+void initList(LinkedList *list);
+
+
+/**
+ * @brief Record a change in the number of elements of a list.
+ *
+ * Updates the length counted by listLength() when `INSTANT_LENGTH` is not
+ * defined, and the length and peak length statistics when `LL_STATS` is.
+ *
+ * @param list The list that changed.
+ * @param change The number of elements added, or negative if removed.
+ */
+void countLength(LinkedList *list, long change);
+
+
+/**
+ * @brief Link a node into a list.
+ *
+ * Links @p node in after @p previous, or at the head if @p previous is `NULL`,
+ * and keeps the tail, previous links, length and finger of @p list up to date.
+ * The node's data must already be set. A list with a hash index must already
+ * have room in it for the node.
+ *
+ * @param list The list to add to.
+ * @param previous The node to link after, or `NULL` for the head.
+ * @param node The node to link in.
+ */
+void linkNode(LinkedList *list, ListNode *previous, ListNode *node);
+
+
+/**
+ * @brief Unlink a node from a list.
+ *
+ * The reverse of linkNode(). The node and its data are not freed.
+ *
+ * @param list The list to remove from.
+ * @param previous The node before @p node, or `NULL` if it is the head.
+ * @param node The node to unlink.
+ */
+void unlinkNode(LinkedList *list, ListNode *previous, ListNode *node);
+
+
+#ifdef LL_STATS
+/**
+ * @brief Add the statistics of a list that is about to be freed to the totals
+ *        returned by getListStats().
+ *
+ * @param list The list being freed.
+ */
+void retireStats(LinkedList *list);
+
+
+/**
+ * @brief Count a destroyed list in the totals returned by getListStats().
+ *
+ * @param start The `clock()` when destroying the list began.
+ */
+void countDestroyed(clock_t start);
+#endif
+
+
+#endif /* end of include guard: LISTINTERNAL_H */
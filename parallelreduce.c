@@ -0,0 +1,111 @@
+/**
+ * @file    parallelreduce.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Parallel reduce source file. Each segment of the list is reduced on
+ *          a POSIX thread and the results combined in order.
+ */
+
+#include <pthread.h>
+#include "parallelreduce.h"
+
+
+/**
+ * A `struct` describing a segment of a list reduced by a single thread.
+ */
+typedef struct Segment {
+    ListNode *start;
+    unsigned long count;
+    Reducer reducer;
+    void *result;
+    pthread_t thread;
+    int running;
+} Segment;
+
+
+/**
+ * Reduce the nodes of a segment, storing the result within it.
+ */
+static void *reduceSegment(void *argument)
+{
+    Segment *segment = (Segment *) argument;
+    ListNode *current = segment->start;
+    unsigned long i;
+
+    for (i = 0; i < segment->count; i++)
+    {
+        segment->result = segment->reducer(current->data, segment->result);
+        current = current->next;
+    }
+
+    return NULL;
+}
+
+
+void *reduceListParallel(LinkedList *list, Reducer mapReducer,
+        Combiner combiner, IdentityFunc identity, unsigned int nthreads)
+{
+    Segment *segments;
+    ListNode *current;
+    unsigned long length;
+    unsigned long i;
+    unsigned int count;
+    unsigned int s;
+    void *result;
+
+    length = listLength(list);
+
+    /* use no more threads than there are elements */
+    count = nthreads;
+    if (count > length)
+        count = (unsigned int) length;
+
+    /* nothing to split so reduce on this thread */
+    if (count <= 1)
+        return reduceList(list, mapReducer, identity());
+
+    segments = (Segment *) malloc(count * sizeof(Segment));
+    if (!segments)
+        return reduceList(list, mapReducer, identity());
+
+    /* walk the list once, starting each thread as soon as its segment is
+     * found so the walk overlaps with the reductions */
+    current = list->head;
+    for (s = 0; s < count; s++)
+    {
+        Segment *segment = &segments[s];
+
+        segment->start = current;
+        segment->count = length / count + (s < length % count ? 1 : 0);
+        segment->reducer = mapReducer;
+        segment->result = identity();
+        segment->running = FALSE;
+
+        /* the last segment is reduced by the calling thread */
+        if (s == count - 1)
+            break;
+
+        /* fall back to reducing here if a thread cannot be started */
+        if (pthread_create(&segment->thread, NULL, &reduceSegment, segment) == 0)
+            segment->running = TRUE;
+        else
+            reduceSegment(segment);
+
+        for (i = 0; i < segment->count; i++)
+            current = current->next;
+    }
+    reduceSegment(&segments[count - 1]);
+
+    /* wait for every thread then combine the results in list order */
+    result = NULL;
+    for (s = 0; s < count; s++)
+    {
+        if (segments[s].running)
+            pthread_join(segments[s].thread, NULL);
+
+        result = s ? combiner(result, segments[s].result) : segments[s].result;
+    }
+
+    free(segments);
+    return result;
+}
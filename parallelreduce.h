@@ -0,0 +1,67 @@
+/**
+ * @file    parallelreduce.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Parallel reduce operation for linked lists using POSIX threads.
+ */
+
+
+#ifndef PARALLELREDUCE_H
+#define PARALLELREDUCE_H
+
+
+#include "linkedlist.h"
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * @brief A function pointer type that creates the starting value of a
+ *        reduction.
+ *
+ * The user defines a function of this type that returns a new carry value
+ * holding the identity of the combiner (eg. zero for a sum). It is called once
+ * for each segment of the list so segments never share a carry value.
+ */
+typedef void *(* IdentityFunc)(void);
+
+
+/**
+ * @brief A function pointer type that combines two partial reductions.
+ *
+ * The first argument is the result of reducing an earlier part of the list and
+ * the second the result of the part directly after it. The function should
+ * return the combined result, freeing the second argument if required. The
+ * combination must be associative, but need not be commutative.
+ */
+typedef void *(* Combiner)(void *, void *);
+
+
+/***** FUNCTIONS *****/
+
+/**
+ * @brief Perform a reduce operation on the list using multiple threads.
+ *
+ * Splits @p list into @p nthreads segments of consecutive elements and reduces
+ * each on its own thread with @p mapReducer, starting from a new value from
+ * @p identity. The partial results are then merged in list order with
+ * @p combiner. The list is split by a single walk along it, so the speedup is
+ * greatest when @p mapReducer costs more than following a pointer. The calling
+ * thread reduces the last segment itself.
+ *
+ * @p mapReducer is called concurrently so must not modify shared state. The
+ * @p identity and @p combiner functions are only called from the calling
+ * thread.
+ *
+ * @param list A list to reduce to a single value.
+ * @param mapReducer A function called for each element, as for reduceList().
+ * @param combiner A function that merges the results of adjacent segments.
+ * @param identity A function returning the starting value of a segment.
+ * @param nthreads The number of threads to use, including the caller.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceListParallel(LinkedList *list, Reducer mapReducer,
+        Combiner combiner, IdentityFunc identity, unsigned int nthreads);
+
+
+#endif /* end of include guard: PARALLELREDUCE_H */
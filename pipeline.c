@@ -0,0 +1,226 @@
+/**
+ * @file    pipeline.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Pipeline source file. Every run makes a single pass over the source
+ *          list, passing each element through all of the stages in turn.
+ */
+
+#include "pipeline.h"
+
+
+/* The state of a collectPipeline() run, passed to appendElement() */
+typedef struct Collector {
+    ListCursor cursor;
+    int failed;
+} Collector;
+
+
+/***** STATIC FUNCTIONS *****/
+
+/**
+ * Add a stage to the end of a pipeline, returning `NULL` if it is full.
+ */
+static PipelineStage *addStage(Pipeline *pipeline, int type, void *context)
+{
+    PipelineStage *stage;
+
+    if (!pipeline || pipeline->count == PIPELINE_MAX_STAGES)
+        return NULL;
+
+    stage = &pipeline->stages[pipeline->count++];
+    stage->type = type;
+    stage->context = context;
+    stage->limit = 0;
+
+    return stage;
+}
+
+
+/**
+ * Pass each element of the source list through the stages, calling @p callback
+ * on those that reach the end. The traversal stops once a take stage is full.
+ */
+static void *runStages(Pipeline *pipeline, Reducer callback, void *seed)
+{
+    unsigned long taken[PIPELINE_MAX_STAGES];
+    ListNode *current;
+    DataPointer data;
+    unsigned int i;
+    int finished = FALSE;
+
+    if (!pipeline || !pipeline->source)
+        return seed;
+
+    for (i = 0; i < pipeline->count; i++)
+    {
+        taken[i] = 0;
+        if (pipeline->stages[i].type == STAGE_TAKE && !pipeline->stages[i].limit)
+            finished = TRUE;
+    }
+
+    for (current = pipeline->source->head; current && !finished; current = current->next)
+    {
+        data = current->data;
+
+        for (i = 0; i < pipeline->count; i++)
+        {
+            PipelineStage *stage = &pipeline->stages[i];
+
+            if (stage->type == STAGE_MAP)
+                data = stage->function.map(data, stage->context);
+            else if (stage->type == STAGE_FILTER)
+            {
+                if (!stage->function.filter(data, stage->context))
+                    break;
+            }
+            else if (stage->type == STAGE_TAKE)
+            {
+                /* this element still passes, but no later one can */
+                if (++taken[i] == stage->limit)
+                    finished = TRUE;
+            }
+            else
+                stage->function.forEach(data, stage->context);
+        }
+
+        /* the element was not dropped by a filter */
+        if (i == pipeline->count)
+            seed = callback(data, seed);
+    }
+
+    return seed;
+}
+
+
+/**
+ * Count the elements output by a pipeline.
+ */
+static void *countElement(DataPointer data, void *count)
+{
+    (void) data;
+    ++*(unsigned long *) count;
+    return count;
+}
+
+
+/**
+ * Append an element to the end of the list being collected.
+ */
+static void *appendElement(DataPointer data, void *collector)
+{
+    Collector *state = (Collector *) collector;
+
+    if (!state->failed && !cursorInsertBefore(&state->cursor, data))
+        state->failed = TRUE;
+
+    return collector;
+}
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+void initPipeline(Pipeline *pipeline, LinkedList *source)
+{
+    if (!pipeline)
+        return;
+
+    pipeline->source = source;
+    pipeline->count = 0;
+}
+
+
+int pipelineMap(Pipeline *pipeline, MapFunc map, void *context)
+{
+    PipelineStage *stage;
+
+    if (!map || !(stage = addStage(pipeline, STAGE_MAP, context)))
+        return FALSE;
+
+    stage->function.map = map;
+    return TRUE;
+}
+
+
+int pipelineFilter(Pipeline *pipeline, FilterFunc filter, void *context)
+{
+    PipelineStage *stage;
+
+    if (!filter || !(stage = addStage(pipeline, STAGE_FILTER, context)))
+        return FALSE;
+
+    stage->function.filter = filter;
+    return TRUE;
+}
+
+
+int pipelineTake(Pipeline *pipeline, unsigned long limit)
+{
+    PipelineStage *stage = addStage(pipeline, STAGE_TAKE, NULL);
+
+    if (!stage)
+        return FALSE;
+
+    stage->limit = limit;
+    return TRUE;
+}
+
+
+int pipelineForEach(Pipeline *pipeline, ForEachFunc forEach, void *context)
+{
+    PipelineStage *stage;
+
+    if (!forEach || !(stage = addStage(pipeline, STAGE_FOR_EACH, context)))
+        return FALSE;
+
+    stage->function.forEach = forEach;
+    return TRUE;
+}
+
+
+/***** EXECUTION FUNCTIONS *****/
+
+unsigned long runPipeline(Pipeline *pipeline)
+{
+    unsigned long count = 0;
+
+    runStages(pipeline, &countElement, &count);
+    return count;
+}
+
+
+void *reducePipeline(Pipeline *pipeline, Reducer callback, void *seed)
+{
+    if (!callback)
+        return seed;
+
+    return runStages(pipeline, callback, seed);
+}
+
+
+LinkedList *collectPipeline(Pipeline *pipeline, FreeDataFunc freeData)
+{
+    Collector state;
+    LinkedList *list;
+
+    if (!pipeline || !pipeline->source)
+        return NULL;
+
+    list = createListWithAllocator(NULL, freeData);
+    if (!list)
+        return NULL;
+
+    /* a cursor past the end appends in constant time */
+    initCursor(&state.cursor, list);
+    state.failed = FALSE;
+
+    runStages(pipeline, &appendElement, &state);
+
+    if (state.failed)
+    {
+        destroyList(list);
+        return NULL;
+    }
+
+    return list;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file    pipeline.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Lazy pipelines over linked lists. Map, filter, take and forEach
+ *          stages are recorded first and then run together in a single pass
+ *          over the list, without building a list between stages.
+ */
+
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The greatest number of stages a single pipeline can hold. The stages are
+ * stored inside the pipeline so it can live on the stack.
+ */
+#ifndef PIPELINE_MAX_STAGES
+    #define PIPELINE_MAX_STAGES 16
+#endif
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * @brief A function pointer type that transforms an element.
+ *
+ * The first argument is the element and the second the context given when the
+ * stage was added. The function returns the element passed to the next stage.
+ */
+typedef DataPointer (* MapFunc)(DataPointer, void *);
+
+
+/**
+ * @brief A function pointer type that selects elements.
+ *
+ * The first argument is the element and the second the context given when the
+ * stage was added. The function returns non-zero to keep the element.
+ */
+typedef int (* FilterFunc)(DataPointer, void *);
+
+
+/**
+ * @brief A function pointer type that is called for each element.
+ *
+ * The first argument is the element and the second the context given when the
+ * stage was added.
+ */
+typedef void (* ForEachFunc)(DataPointer, void *);
+
+
+/**
+ * A `struct` representing a single stage of a pipeline. Only the function
+ * matching `type` is set, and `limit` is only used by take stages.
+ */
+typedef struct PipelineStage {
+    enum { STAGE_MAP, STAGE_FILTER, STAGE_TAKE, STAGE_FOR_EACH } type;
+    union {
+        MapFunc map;
+        FilterFunc filter;
+        ForEachFunc forEach;
+    } function;
+    void *context;
+    unsigned long limit;
+} PipelineStage;
+
+
+/**
+ * A `struct` representing a pipeline over a list. See initPipeline().
+ */
+typedef struct Pipeline {
+    LinkedList *source;
+    PipelineStage stages[PIPELINE_MAX_STAGES];
+    unsigned int count;
+} Pipeline;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+/* Adding a stage does not visit the list. The stages are run in the order they
+ * were added, each element passing through every stage before the next element
+ * is read. Nothing is freed by a pipeline, so elements created by a map stage
+ * and then dropped by a later filter or take stage are not freed. */
+
+/**
+ * @brief Start an empty pipeline over a list.
+ *
+ * An empty pipeline passes every element through unchanged. The list must not
+ * be changed while the pipeline is run.
+ *
+ * @param pipeline The pipeline to initialise. It may be on the stack.
+ * @param source The list to read elements from.
+ */
+void initPipeline(Pipeline *pipeline, LinkedList *source);
+
+
+/**
+ * @brief Add a stage that replaces each element with the result of a function.
+ *
+ * @param pipeline The pipeline to add to.
+ * @param map The function to call on each element.
+ * @param context A value passed to each call of @p map.
+ * @return Positive integer if the stage was added, zero otherwise.
+ */
+int pipelineMap(Pipeline *pipeline, MapFunc map, void *context);
+
+
+/**
+ * @brief Add a stage that only keeps the elements a function accepts.
+ *
+ * @param pipeline The pipeline to add to.
+ * @param filter The function to call on each element.
+ * @param context A value passed to each call of @p filter.
+ * @return Positive integer if the stage was added, zero otherwise.
+ */
+int pipelineFilter(Pipeline *pipeline, FilterFunc filter, void *context);
+
+
+/**
+ * @brief Add a stage that only keeps the first elements to reach it.
+ *
+ * Once @p limit elements have passed no later element can reach the end of the
+ * pipeline, so the rest of the list is not visited.
+ *
+ * @param pipeline The pipeline to add to.
+ * @param limit The number of elements to keep.
+ * @return Positive integer if the stage was added, zero otherwise.
+ */
+int pipelineTake(Pipeline *pipeline, unsigned long limit);
+
+
+/**
+ * @brief Add a stage that calls a function on each element and passes it on.
+ *
+ * @param pipeline The pipeline to add to.
+ * @param forEach The function to call on each element.
+ * @param context A value passed to each call of @p forEach.
+ * @return Positive integer if the stage was added, zero otherwise.
+ */
+int pipelineForEach(Pipeline *pipeline, ForEachFunc forEach, void *context);
+
+
+/***** EXECUTION FUNCTIONS *****/
+/* Each of the functions below runs the pipeline once, in a single pass over the
+ * source list. A pipeline may be run any number of times. */
+
+/**
+ * @brief Run a pipeline for the effects of its stages.
+ *
+ * @param pipeline The pipeline to run.
+ * @return The number of elements that reached the end of the pipeline.
+ */
+unsigned long runPipeline(Pipeline *pipeline);
+
+
+/**
+ * @brief Perform a reduce operation on the output of a pipeline.
+ *
+ * Behaves the same as reduceList(), calling @p callback on each element that
+ * reaches the end of the pipeline.
+ *
+ * @param pipeline The pipeline to run.
+ * @param callback A function called for each element output.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the output.
+ */
+void *reducePipeline(Pipeline *pipeline, Reducer callback, void *seed);
+
+
+/**
+ * @brief Store the output of a pipeline in a new list.
+ *
+ * The elements are added in order to a list from createListWithAllocator().
+ * If the elements are still owned by the source list, @p freeData should be
+ * `NULL` so they are not freed twice.
+ *
+ * @param pipeline The pipeline to run.
+ * @param freeData The function the new list calls on the data of each removed
+ *                 element, or `NULL` if it does not own its data.
+ * @return A pointer to a new list of the output or `NULL` on error, in which
+ *         case the elements already added are freed with @p freeData.
+ */
+LinkedList *collectPipeline(Pipeline *pipeline, FreeDataFunc freeData);
+
+
+#endif /* end of include guard: PIPELINE_H */
@@ -0,0 +1,293 @@
+/**
+ * @file    skiplist.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Skip list source file. Every level is addressed through a pointer to
+ *          the link that leads into it, so the head of the list needs no
+ *          special cases.
+ */
+
+#include "skiplist.h"
+#include "listinternal.h"
+
+
+/* The seed for the level of each inserted node */
+#define SKIP_RANDOM_SEED 2463534242UL
+
+
+/***** INTERNAL FUNCTIONS *****/
+
+/**
+ * Get the link leaving @p node on @p level, where a `NULL` node is the head of
+ * the list.
+ */
+static ListNode **linkAt(SkipList *list, SkipNode *node, unsigned int level)
+{
+    if (!node)
+        return level ? &list->heads[level - 1] : &list->base.head;
+
+    return level ? &node->forward[level - 1] : &node->base.next;
+}
+
+
+/**
+ * Pick the number of levels for a new node. Each level above the first is
+ * taken with a probability of one quarter.
+ */
+static unsigned int randomLevels(SkipList *list)
+{
+    uint32_t x = list->random;
+    unsigned int levels = 1;
+
+    /* xorshift */
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    list->random = x;
+
+    while ((x & 3) == 0 && levels < SKIP_MAX_LEVEL)
+    {
+        levels++;
+        x >>= 2;
+    }
+
+    return levels;
+}
+
+
+/**
+ * Find the link on each level that leads to the first node not less than
+ * @p value, or with @p after set, the first node greater than it. The links
+ * are stored in @p links and the node before on the bottom level is returned,
+ * which is `NULL` for the head.
+ */
+static SkipNode *findLinks(SkipList *list, DataPointer value, int after,
+        ListNode **links[])
+{
+    SkipNode *node = NULL;
+    ListNode *stop = NULL;
+    unsigned int level = list->levels;
+
+    /* move right while the next node is before the value, then down */
+    while (level-- > 0)
+    {
+        ListNode **link = linkAt(list, node, level);
+        while (*link)
+        {
+            int difference;
+
+            /* the node that ended the level above does not need comparing */
+            if (*link == stop)
+                break;
+
+            difference = list->base.difference((*link)->data, value);
+            if (difference > 0 || (difference == 0 && !after))
+            {
+                stop = *link;
+                break;
+            }
+
+            node = (SkipNode *) *link;
+            link = linkAt(list, node, level);
+        }
+
+        links[level] = link;
+    }
+
+    return node;
+}
+
+
+SkipList* createSkipList(DifferenceFunc difference)
+{
+    SkipList *list;
+    unsigned int i;
+
+    if (!difference)
+        return NULL;
+
+    list = (SkipList *) malloc(sizeof(SkipList));
+    if (list)
+    {
+        initList(&list->base);
+        list->base.difference = difference;
+        for (i = 0; i < SKIP_MAX_LEVEL - 1; i++)
+            list->heads[i] = NULL;
+        list->levels = 1;
+#ifndef INSTANT_LENGTH
+        list->length = 0;
+#endif
+        list->random = SKIP_RANDOM_SEED;
+    }
+
+    return list;
+}
+
+
+void *reduceSkipList(SkipList *list, Reducer callback, void *seed)
+{
+    return list ? reduceList(&list->base, callback, seed) : seed;
+}
+
+
+int insertSkipSorted(SkipList *list, DataPointer value)
+{
+    ListNode **links[SKIP_MAX_LEVEL];
+    SkipNode *previous;
+    SkipNode *node;
+    unsigned int levels;
+    unsigned int level;
+
+    if (!list)
+        return FALSE;
+
+    levels = randomLevels(list);
+    node = (SkipNode *) malloc(sizeof(SkipNode) +
+            (levels > 1 ? levels - 2 : 0) * sizeof(ListNode *));
+    if (!node)
+        return FALSE;
+    node->base.data = value;
+    node->levels = levels;
+
+    /* go after any equal elements, starting new levels from the head */
+    previous = findLinks(list, value, TRUE, links);
+    for (; list->levels < levels; list->levels++)
+        links[list->levels] = linkAt(list, NULL, list->levels);
+
+    /* the bottom level is linked like any other list */
+    linkNode(&list->base, previous ? &previous->base : NULL, &node->base);
+    for (level = 1; level < levels; level++)
+    {
+        *linkAt(list, node, level) = *links[level];
+        *links[level] = &node->base;
+    }
+
+    STAT_ADD(&list->base, allocations, 1);
+#ifndef INSTANT_LENGTH
+    list->length++;
+#endif
+
+    return TRUE;
+}
+
+
+void destroySkipList(SkipList *list)
+{
+#ifdef LL_STATS
+    clock_t start = clock();
+#endif
+
+    if (list)
+    {
+        /* the bottom level holds every node */
+        while (list->base.head)
+        {
+            ListNode *top = list->base.head;
+
+            unlinkNode(&list->base, NULL, top);
+            STAT_ADD(&list->base, frees, 1);
+            if (list->base.freeData)
+                list->base.freeData(top->data);
+            free(top);
+        }
+
+#ifdef LL_STATS
+        retireStats(&list->base);
+        countDestroyed(start);
+#endif
+        free(list);
+    }
+}
+
+
+int removeSkipElement(SkipList *list, DataPointer value)
+{
+    ListNode **links[SKIP_MAX_LEVEL];
+    SkipNode *previous;
+    SkipNode *node;
+    unsigned int level;
+
+    if (!list)
+        return FALSE;
+
+    previous = findLinks(list, value, FALSE, links);
+    node = (SkipNode *) *links[0];
+    if (!node || list->base.difference(node->base.data, value) != 0)
+        return FALSE;
+
+    /* the first equal node is the first reached on each of its levels */
+    for (level = 1; level < node->levels; level++)
+        *links[level] = *linkAt(list, node, level);
+    unlinkNode(&list->base, previous ? &previous->base : NULL, &node->base);
+
+    STAT_ADD(&list->base, frees, 1);
+#ifndef INSTANT_LENGTH
+    list->length--;
+#endif
+
+    /* drop empty levels from the top */
+    while (list->levels > 1 && !*linkAt(list, NULL, list->levels - 1))
+        list->levels--;
+
+    if (list->base.freeData)
+        list->base.freeData(node->base.data);
+    free(node);
+
+    return TRUE;
+}
+
+
+DataPointer findSkipElement(SkipList *list, DataPointer needle)
+{
+    ListNode **links[SKIP_MAX_LEVEL];
+    ListNode *node;
+
+    if (!list)
+        return NULL;
+
+    findLinks(list, needle, FALSE, links);
+    node = *links[0];
+    if (node && list->base.difference(node->data, needle) == 0)
+        return node->data;
+
+    return NULL;
+}
+
+
+unsigned long skipListLength(SkipList *list)
+{
+#ifdef INSTANT_LENGTH
+    return list ? list->base.length : 0;
+#else
+    return list ? list->length : 0;
+#endif
+}
+
+
+DataPointer peekSkipTop(SkipList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->base.head)
+        return list->base.head->data;
+
+    return NULL;
+}
+
+
+DataPointer peekSkipTail(SkipList *list)
+{
+    SkipNode *node = NULL;
+    unsigned int level;
+
+    if (!list)
+        return NULL;
+
+    /* take the highest level as far as it goes, then drop down */
+    for (level = list->levels; level > 0; level--)
+    {
+        while (*linkAt(list, node, level - 1))
+            node = (SkipNode *) *linkAt(list, node, level - 1);
+    }
+
+    return node ? node->base.data : NULL;
+}
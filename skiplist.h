@@ -0,0 +1,173 @@
+/**
+ * @file    skiplist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Sorted skip list. Nodes are linked in order like a normal list, and
+ *          a random number of extra levels skip over runs of nodes so that
+ *          searching, insertion and removal take O(log n) expected time.
+ */
+
+
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The most levels a node in a skip list can have. Each level holds a quarter of
+ * the nodes of the level below, so 16 levels suit lists of up to 2^32 elements.
+ */
+#ifndef SKIP_MAX_LEVEL
+    #define SKIP_MAX_LEVEL 16
+#endif
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` representing a node within a skip list. The base node links the
+ * node into the bottom level. `forward[i]` is the next node on level `i + 1`,
+ * and there are `levels - 1` of them.
+ */
+typedef struct SkipNode {
+    ListNode base;
+    unsigned int levels;
+    ListNode *forward[1];
+} SkipNode;
+
+
+/**
+ * A `struct` representing a skip list. The bottom level is the linked list
+ * `base`, so it can be passed to the read only linked list functions such as
+ * reduceList(), peekTop() and listLength(). It must not be modified through
+ * them. `base.difference` orders the list, and `base.freeData` is called on
+ * each removed element as for a linked list. `length` counts the elements
+ * when the base list does not store its own length.
+ */
+typedef struct SkipList {
+    LinkedList base;
+    ListNode *heads[SKIP_MAX_LEVEL - 1];
+    unsigned int levels;
+#ifndef INSTANT_LENGTH
+    unsigned long length;
+#endif
+    uint32_t random;
+} SkipList;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Create a new empty skip list.
+ *
+ * @param difference The function used to order the elements.
+ * @return A pointer to a new empty skip list, or `NULL` on error or if
+ *         @p difference is `NULL`.
+ */
+SkipList* createSkipList(DifferenceFunc difference);
+
+
+/**
+ * @brief Perform a reduce operation on a skip list.
+ *
+ * Behaves the same as reduceList(), calling @p callback on each element in
+ * sorted order.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each element in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceSkipList(SkipList *list, Reducer callback, void *seed);
+
+
+/**
+ * @brief Insert a value in sorted order into a skip list.
+ *
+ * Takes O(log n) expected time. Equal elements keep the order they were
+ * inserted in. As for insertTop(), the list takes ownership of @p value.
+ *
+ * @param list The list to add to.
+ * @param value The data to insert into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertSkipSorted(SkipList *list, DataPointer value);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete an entire skip list.
+ *
+ * Frees all the memory associated with @p list, and calls the list's
+ * `freeData` function on each element.
+ *
+ * @param list The list to delete.
+ */
+void destroySkipList(SkipList *list);
+
+
+/**
+ * @brief Remove an element that matches a specified value.
+ *
+ * Removes the first element of @p list that the list's difference function
+ * finds equal to @p value, and calls the list's `freeData` function on it. Takes
+ * O(log n) expected time.
+ *
+ * @param list The list to remove from.
+ * @param value The value to compare against.
+ * @return Positive integer for successful removal, zero otherwise.
+ */
+int removeSkipElement(SkipList *list, DataPointer value);
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+/**
+ * @brief Find an element within a skip list.
+ *
+ * Takes O(log n) expected time.
+ *
+ * @param list The list to search through.
+ * @param needle The value to compare against.
+ * @return A pointer to the first element equal to @p needle, or `NULL` if one
+ *         is not found.
+ */
+DataPointer findSkipElement(SkipList *list, DataPointer needle);
+
+
+/**
+ * @brief Get the number of elements in a skip list.
+ *
+ * @param list The list to determine the length of.
+ * @return The size of the supplied list.
+ */
+unsigned long skipListLength(SkipList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the smallest element of a skip list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the first element, or `NULL` if empty.
+ */
+DataPointer peekSkipTop(SkipList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the largest element of a skip list.
+ *
+ * Takes O(log n) expected time.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the last element, or `NULL` if empty.
+ */
+DataPointer peekSkipTail(SkipList *list);
+
+
+#endif /* end of include guard: SKIPLIST_H */
@@ -15,7 +15,20 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <cmocka.h>
+#include <pthread.h>
 #include "../linkedlist.h"
+#include "../unrolledlist.h"
+#include "../parallelreduce.h"
+#include "../concurrentstack.h"
+#include "../concurrentqueue.h"
+#include "../intrusivelist.h"
+#include "../frozenlist.h"
+#include "../skiplist.h"
+#include "../xorlist.h"
+#include "../compactlist.h"
+#include "../typedlist.h"
+#include "../pipeline.h"
+#include "../keyedlist.h"
 
 //TODO add comments
 static void test_createList(void **state)
@@ -108,6 +121,15 @@ static void test_listLength(void **state)
         insertTop(list, malloc(sizeof(char)));
         assert_int_equal(listLength(list), i + 1);
     }
+
+    // the counted length follows removals and resets
+    removeIndex(list, -1);
+    removeTop(list);
+    assert_int_equal(listLength(list), l - 2);
+    resetList(list);
+    assert_int_equal(listLength(list), 0);
+    insertTail(list, malloc(sizeof(char)));
+    assert_int_equal(listLength(list), 1);
     destroyList(list);
 }
 
@@ -224,6 +246,2274 @@ static void test_peekTail(void **state)
 }
 
 
+static void test_mixedEnds(void **state)
+{
+    const int a = 101;
+    LinkedList *list = createList();
+    assert_non_null(list);
+
+    // build the list 0..a-1 from both ends
+    for (int i = a / 2; i >= 0; i--)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        insertTop(list, c);
+    }
+    for (int i = a / 2 + 1; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        insertTail(list, c);
+    }
+    assert_int_equal(listLength(list), a);
+
+    // remove from both ends checking the remaining ends each time
+    for (int i = 0; i < a / 2; i++)
+    {
+        assert_int_equal(*(int*)peekTop(list), i);
+        assert_int_equal(*(int*)peekTail(list), a - 1 - i);
+        removeTop(list);
+        removeTail(list);
+        assert_int_equal(listLength(list), a - 2 * (i + 1));
+    }
+    assert_int_equal(*(int*)peekTop(list), a / 2);
+    assert_ptr_equal(peekTop(list), peekTail(list));
+
+    // emptying the list must leave it usable from either end
+    removeTail(list);
+    assert_null(peekTop(list));
+    assert_null(peekTail(list));
+    assert_int_equal(listLength(list), 0);
+    int *c = malloc(sizeof(int));
+    insertTail(list, c);
+    assert_ptr_equal(peekTop(list), c);
+    assert_ptr_equal(peekTail(list), c);
+
+    destroyList(list);
+}
+
+
+static void test_createListWithPool(void **state)
+{
+    const int a = 1001;
+    LinkedList *list = createListWithPool(16);
+    assert_non_null(list);
+    assert_null(list->head);
+    assert_non_null(list->pool);
+
+    // fill well past the first slab
+    for (int i = 0; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        assert_true(insertTail(list, c));
+    }
+    assert_int_equal(listLength(list), a);
+    assert_int_equal(*(int*)peekTop(list), 0);
+    assert_int_equal(*(int*)peekTail(list), a - 1);
+
+    // removed nodes are reused rather than growing the pool
+    ListNode *top = list->head;
+    removeTop(list);
+    removeTail(list);
+    insertTop(list, malloc(sizeof(int)));
+    insertTop(list, malloc(sizeof(int)));
+    assert_int_equal(listLength(list), a);
+    assert_ptr_equal(list->head, top);
+
+    destroyList(list);
+}
+
+
+static void test_shrinkPool(void **state)
+{
+    const int a = 1000;
+    assert_int_equal(shrinkPool(NULL), 0);
+
+    LinkedList *list = createList();
+    assert_int_equal(shrinkPool(list), 0);
+    destroyList(list);
+
+    list = createListWithPool(10);
+    for (int i = 0; i < a; i++)
+        insertTop(list, malloc(sizeof(int)));
+
+    // nothing can be released while every slab has a node in use
+    for (int i = 0; i < a - 1; i++)
+        removeTail(list);
+    unsigned long released = shrinkPool(list);
+    assert_true(released > 0);
+    assert_int_equal(shrinkPool(list), 0);
+
+    // the pool must still work after shrinking
+    for (int i = 0; i < a; i++)
+        insertTail(list, malloc(sizeof(int)));
+    assert_int_equal(listLength(list), a + 1);
+    for (int i = 0; i <= a; i++)
+        removeTop(list);
+    assert_true(shrinkPool(list) >= a);
+    insertTop(list, malloc(sizeof(int)));
+
+    destroyList(list);
+}
+
+
+static void test_insertArray(void **state)
+{
+    const int a = 100;
+    DataPointer items[100];
+    assert_false(insertArrayTop(NULL, items, a));
+
+    LinkedList *list = createList();
+    assert_false(insertArrayTail(list, NULL, a));
+    assert_true(insertArrayTail(list, NULL, 0));
+    assert_null(list->head);
+
+    // nodes allocated one at a time before the list has a pool
+    int *c = malloc(sizeof(int));
+    *c = -1;
+    insertTop(list, c);
+
+    for (int i = 0; i < a; i++)
+    {
+        items[i] = malloc(sizeof(int));
+        *(int *) items[i] = i;
+    }
+    assert_true(insertArrayTail(list, items, a));
+    assert_non_null(list->pool);
+    assert_int_equal(listLength(list), a + 1);
+    assert_int_equal(*(int *) peekTail(list), a - 1);
+
+    for (int i = 0; i < a; i++)
+    {
+        items[i] = malloc(sizeof(int));
+        *(int *) items[i] = a + i;
+    }
+    assert_true(insertArrayTop(list, items, a));
+    assert_int_equal(listLength(list), 2 * a + 1);
+
+    // the array order is kept at both ends: a..2a-1, -1, 0..a-1
+    int expected = a;
+    ListNode *node = list->head;
+    for (int i = 0; i < 2 * a + 1; i++, node = node->next)
+    {
+        if (i == a)
+            assert_int_equal(*(int *) node->data, -1);
+        else
+        {
+            assert_int_equal(*(int *) node->data, expected % (2 * a));
+            expected++;
+        }
+    }
+    assert_null(node);
+
+    // the stray node and the emptied blocks are handed back
+    for (int i = 0; i < a; i++)
+        removeTail(list);
+    removeTail(list);
+    assert_true(shrinkPool(list) >= 1);
+    assert_int_equal(*(int *) peekTail(list), 2 * a - 1);
+    assert_int_equal(*(int *) peekTop(list), a);
+
+    destroyList(list);
+
+    // a stray node is still freed when the list is destroyed without shrinking
+    list = createList();
+    insertTop(list, malloc(sizeof(int)));
+    items[0] = malloc(sizeof(int));
+    assert_true(insertArrayTop(list, items, 1));
+    destroyList(list);
+}
+
+
+typedef struct Record {
+    int id;
+    double value;
+    char name[20];
+} Record;
+
+static void *recordReducer(DataPointer data, void *carry)
+{
+    *(long *) carry += ((Record *) data)->id;
+    return carry;
+}
+
+static int freedRecords;
+
+static void freeRecord(DataPointer data)
+{
+    freedRecords++;
+    free(data);
+}
+
+static void test_createInlineList(void **state)
+{
+    const int a = 100;
+    assert_null(createInlineList(0));
+
+    LinkedList *list = createInlineList(sizeof(Record));
+    assert_non_null(list);
+    assert_null(list->head);
+    assert_int_equal(list->elementSize, sizeof(Record));
+
+    // elements are copied from the stack, so nothing is allocated for the data
+    for (int i = 0; i < a; i++)
+    {
+        Record record = { i, i * 0.5, "record" };
+        assert_true(insertTail(list, &record));
+        record.id = -1;
+    }
+    assert_int_equal(listLength(list), a);
+
+    Record *top = peekTop(list);
+    assert_int_equal(top->id, 0);
+    assert_string_equal(top->name, "record");
+    Record *tail = peekTail(list);
+    assert_int_equal(tail->id, a - 1);
+    assert_true(tail->value == (a - 1) * 0.5);
+
+    // the element is stored directly after its node
+    assert_ptr_equal(list->head->data, list->head + 1);
+
+    // popping would hand out memory owned by the node
+    assert_null(popTop(list));
+    assert_int_equal(listLength(list), a);
+
+    // removal frees the node only, with the element inside it
+    removeTop(list);
+    removeTail(list);
+    assert_int_equal(((Record *) peekTop(list))->id, 1);
+    assert_int_equal(((Record *) peekTail(list))->id, a - 2);
+
+    long sum = 0;
+    Record first = { 1000, 0, "" };
+    insertTop(list, &first);
+    reduceList(list, &recordReducer, &sum);
+    assert_int_equal(sum, 1000 + (a - 2) * (a - 1) / 2);
+
+    destroyList(list);
+}
+
+
+// orders by the thousands only, so equal keys show whether a sort is stable
+static int keyDifference(DataPointer a, DataPointer b)
+{
+    return *(int *) a / 1000 - *(int *) b / 1000;
+}
+
+static int intDifference(DataPointer a, DataPointer b)
+{
+    return *(int *) a - *(int *) b;
+}
+
+static int *newInt(int value)
+{
+    int *c = malloc(sizeof(int));
+    *c = value;
+    return c;
+}
+
+// checks ordering and links from both ends, returning the number of elements
+static unsigned long assertSorted(LinkedList *list, DifferenceFunc diff)
+{
+    unsigned long length = 0;
+    ListNode *previous = NULL;
+
+    for (ListNode *node = list->head; node; node = node->next, length++)
+    {
+        if (previous)
+            assert_true(diff(previous->data, node->data) <= 0);
+#ifdef DOUBLY_LINKED
+        assert_ptr_equal(node->prev, previous);
+#endif
+        previous = node;
+    }
+#ifdef DOUBLE_ENDED
+    assert_ptr_equal(list->tail, previous);
+#endif
+    assert_int_equal(listLength(list), length);
+
+    return length;
+}
+
+static void test_sortList(void **state)
+{
+    const int a = 1000;
+    sortList(NULL, &intDifference);
+
+    LinkedList *list = createList();
+    sortList(list, &intDifference);
+    assert_null(list->head);
+
+    // nothing happens without a difference function
+    for (int i = 0; i < a; i++)
+        insertTop(list, newInt((i * 7919) % a * 1000 + i));
+    int top = *(int *) peekTop(list);
+    sortList(list, NULL);
+    assert_int_equal(*(int *) peekTop(list), top);
+
+    // sort by key and check equal keys kept their order
+    list->difference = &keyDifference;
+    sortList(list, NULL);
+    assert_int_equal(assertSorted(list, &keyDifference), a);
+    for (ListNode *node = list->head; node->next; node = node->next)
+        if (keyDifference(node->data, node->next->data) == 0)
+            assert_true(*(int *) node->data % 1000 > *(int *) node->next->data % 1000);
+
+    // the argument overrides the field
+    sortList(list, &intDifference);
+    assert_int_equal(assertSorted(list, &intDifference), a);
+
+    // odd lengths and a single element
+    removeTop(list);
+    sortList(list, &intDifference);
+    assert_int_equal(assertSorted(list, &intDifference), a - 1);
+    destroyList(list);
+
+    list = createList();
+    insertTop(list, newInt(1));
+    sortList(list, &intDifference);
+    assert_int_equal(assertSorted(list, &intDifference), 1);
+    destroyList(list);
+}
+
+
+static void test_insertSorted(void **state)
+{
+    const int a = 500;
+    assert_false(insertSorted(NULL, NULL));
+
+    // without a difference function values go on top
+    LinkedList *list = createList();
+    assert_true(insertSorted(list, newInt(-5000)) < 0);
+    assert_true(insertSorted(list, newInt(-3000)) < 0);
+    assert_int_equal(*(int *) peekTop(list), -3000);
+
+    list->difference = &keyDifference;
+    sortList(list, NULL);
+    for (int i = 0; i < a; i++)
+        assert_true(insertSorted(list, newInt((i * 31) % 50 * 1000 + i)) > 0);
+    assert_int_equal(assertSorted(list, &keyDifference), a + 2);
+
+    // equal keys stay in insertion order
+    for (ListNode *node = list->head; node->next; node = node->next)
+        if (keyDifference(node->data, node->next->data) == 0)
+            assert_true(*(int *) node->data < *(int *) node->next->data);
+
+    // in order insertion at either end
+    insertSorted(list, newInt(-10000));
+    insertSorted(list, newInt(100000));
+    assert_int_equal(*(int *) peekTop(list), -10000);
+    assert_int_equal(*(int *) peekTail(list), 100000);
+    destroyList(list);
+
+    // inline lists compare the copies held in the nodes
+    list = createInlineList(sizeof(int));
+    list->difference = &intDifference;
+    for (int i = 0; i < a; i++)
+    {
+        int value = (i * 7) % a;
+        insertSorted(list, &value);
+    }
+    assert_int_equal(assertSorted(list, &intDifference), a);
+    destroyList(list);
+}
+
+
+static void test_mergeLists(void **state)
+{
+    const int a = 300;
+    LinkedList *list = createList();
+    LinkedList *other = createListWithPool(16);
+    assert_false(mergeLists(NULL, other, &intDifference));
+    assert_false(mergeLists(list, list, &intDifference));
+    assert_false(mergeLists(list, other, NULL));
+
+    LinkedList *inline_ = createInlineList(sizeof(int));
+    assert_false(mergeLists(list, inline_, &intDifference));
+    destroyList(inline_);
+
+    // odd numbers in one list, even in the other, with some shared values
+    for (int i = 0; i < a; i++)
+    {
+        insertTail(list, newInt(2 * i + 1));
+        insertTail(other, newInt(2 * i));
+    }
+    insertTail(other, newInt(2 * a + 1));
+
+    list->difference = &intDifference;
+    assert_int_equal(listLength(list), a);
+    assert_true(mergeLists(list, other, NULL));
+    assert_int_equal(assertSorted(list, &intDifference), 2 * a + 1);
+    assert_int_equal(listLength(list), 2 * a + 1);
+    assert_int_equal(*(int *) peekTop(list), 0);
+    assert_int_equal(*(int *) peekTail(list), 2 * a + 1);
+
+    // nodes from either source can be removed and reused
+    for (int i = 0; i < a; i++)
+        removeTop(list);
+    assert_true(shrinkPool(list) > 0);
+    for (int i = 0; i < a; i++)
+        insertSorted(list, newInt(i));
+    assert_int_equal(assertSorted(list, &intDifference), 2 * a + 1);
+
+    // merge a pooled list into another pooled list, and an empty list
+    other = createListWithPool(4);
+    for (int i = 0; i < a; i++)
+        insertTail(other, newInt(i * 3));
+    assert_true(mergeLists(list, other, NULL));
+    assert_int_equal(assertSorted(list, &intDifference), 3 * a + 1);
+    assert_true(mergeLists(list, createList(), NULL));
+    assert_int_equal(assertSorted(list, &intDifference), 3 * a + 1);
+
+    // an empty list takes everything
+    other = createList();
+    assert_true(mergeLists(other, list, &intDifference));
+    assert_int_equal(assertSorted(other, &intDifference), 3 * a + 1);
+
+    // lists that free their elements differently can not be merged
+    list = createListWithAllocator(NULL, NULL);
+    int unowned = a;
+    insertTop(list, &unowned);
+    assert_false(mergeLists(other, list, &intDifference));
+    assert_false(mergeLists(list, other, &intDifference));
+    assert_int_equal(listLength(list), 1);
+    assert_int_equal(assertSorted(other, &intDifference), 3 * a + 1);
+    destroyList(list);
+    destroyList(other);
+}
+
+
+static unsigned long intHash(DataPointer data)
+{
+    return (unsigned long) *(int *) data;
+}
+
+static void test_findElement(void **state)
+{
+    const int a = 100;
+    int needle = 5;
+    assert_null(findElement(NULL, &needle, &intDifference));
+    assert_false(removeElement(NULL, &needle, &intDifference));
+
+    // without an index the list is searched in order
+    LinkedList *list = createList();
+    for (int i = 0; i < a; i++)
+        insertTail(list, newInt(i));
+    assert_null(findElement(list, &needle, NULL));
+    assert_int_equal(*(int *) findElement(list, &needle, &intDifference), 5);
+    list->difference = &intDifference;
+    assert_int_equal(*(int *) findElement(list, &needle, NULL), 5);
+
+    assert_true(removeElement(list, &needle, NULL));
+    assert_null(findElement(list, &needle, NULL));
+    assert_false(removeElement(list, &needle, NULL));
+    needle = 0;
+    assert_true(removeElement(list, &needle, NULL));
+    needle = a - 1;
+    assert_true(removeElement(list, &needle, NULL));
+    assert_int_equal(assertSorted(list, &intDifference), a - 3);
+    assert_int_equal(*(int *) peekTop(list), 1);
+    assert_int_equal(*(int *) peekTail(list), a - 2);
+
+    destroyList(list);
+}
+
+
+static void test_hashIndex(void **state)
+{
+    const int a = 1000;
+    assert_false(attachHashIndex(NULL, &intHash, &intDifference));
+    detachHashIndex(NULL);
+
+    LinkedList *list = createList();
+    for (int i = 0; i < a / 2; i++)
+        insertTail(list, newInt(i));
+    assert_false(attachHashIndex(list, NULL, &intDifference));
+    assert_false(attachHashIndex(list, &intHash, NULL));
+    assert_true(attachHashIndex(list, &intHash, &intDifference));
+    assert_non_null(list->index);
+
+    // elements added later through any insertion are indexed too
+    for (int i = a / 2; i < a; i++)
+    {
+        if (i % 2)
+            insertTail(list, newInt(i));
+        else
+            insertTop(list, newInt(i));
+    }
+    DataPointer items[] = { newInt(a), newInt(a + 1) };
+    insertArrayTail(list, items, 2);
+    for (int i = 0; i <= a + 1; i++)
+        assert_int_equal(*(int *) findElement(list, &i, NULL), i);
+    int missing = a + 2;
+    assert_null(findElement(list, &missing, NULL));
+
+    // removals keep the index in step and the order of the rest intact
+    removeTop(list);
+    removeTail(list);
+    int top = a - 2;
+    int tail = a + 1;
+    assert_null(findElement(list, &top, NULL));
+    assert_null(findElement(list, &tail, NULL));
+    for (int i = 0; i < a / 2; i += 3)
+    {
+        assert_true(removeElement(list, &i, NULL));
+        assert_false(removeElement(list, &i, NULL));
+    }
+    unsigned long length = listLength(list);
+    int previous = *(int *) peekTop(list);
+    for (ListNode *node = list->head->next; node; node = node->next)
+    {
+        int value = *(int *) node->data;
+        if (value < a / 2 && previous < a / 2)
+            assert_true(value > previous);
+        assert_ptr_equal(findElement(list, &value, NULL), node->data);
+        previous = value;
+    }
+
+    // a different comparison searches the list instead
+    int key = 1000;
+    assert_int_equal(*(int *) findElement(list, &key, &keyDifference) / 1000, 1);
+
+    // sorting relinks nodes without disturbing the index
+    sortList(list, &intDifference);
+    for (int i = 1; i < a / 2; i += 3)
+        assert_int_equal(*(int *) findElement(list, &i, NULL), i);
+
+    // merged elements are indexed
+    LinkedList *other = createList();
+    insertTop(other, newInt(-1));
+    assert_true(mergeLists(list, other, &intDifference));
+    int negative = -1;
+    assert_int_equal(*(int *) findElement(list, &negative, NULL), -1);
+    assert_int_equal(listLength(list), length + 1);
+
+    detachHashIndex(list);
+    assert_null(list->index);
+    assert_null(findElement(list, &negative, NULL));
+    assert_true(attachHashIndex(list, &intHash, &intDifference));
+    assert_int_equal(*(int *) findElement(list, &negative, NULL), -1);
+
+    // an element whose hashed value changed can still be removed
+    *(int *) peekTop(list) = a * 10;
+    removeTop(list);
+    assert_int_equal(listLength(list), length);
+    int first = *(int *) peekTop(list);
+    assert_ptr_equal(findElement(list, &first, NULL), peekTop(list));
+
+    destroyList(list);
+}
+
+
+static void test_createListWithArena(void **state)
+{
+    const int a = 1000;
+    int values[1000];
+
+    // pointers are stored but never freed by the list
+    LinkedList *list = createListWithArena(0, 16);
+    assert_non_null(list);
+    assert_null(list->freeData);
+    for (int i = 0; i < a; i++)
+    {
+        values[i] = i;
+        assert_true(insertTail(list, &values[i]));
+    }
+    assert_int_equal(listLength(list), a);
+    assert_ptr_equal(peekTail(list), &values[a - 1]);
+    removeTop(list);
+    removeTail(list);
+    assert_ptr_equal(peekTop(list), &values[1]);
+
+    // resetting drops every chunk, and the list can be filled again
+    resetList(list);
+    assert_null(list->head);
+    assert_int_equal(listLength(list), 0);
+    assert_null(peekTail(list));
+    for (int i = 0; i < a; i++)
+        insertTop(list, &values[i]);
+    assert_ptr_equal(peekTop(list), &values[a - 1]);
+    destroyList(list);
+
+    // copied elements live in the chunks too
+    list = createListWithArena(sizeof(Record), 0);
+    for (int i = 0; i < a; i++)
+    {
+        Record record = { i, 0, "arena" };
+        insertTop(list, &record);
+    }
+    assert_int_equal(((Record *) peekTail(list))->id, 0);
+    assert_string_equal(((Record *) peekTop(list))->name, "arena");
+    destroyList(list);
+}
+
+
+static void test_resetList(void **state)
+{
+    const int a = 100;
+    resetList(NULL);
+
+    // a custom free function is called for every element
+    LinkedList *list = createList();
+    list->freeData = &freeRecord;
+    for (int i = 0; i < a; i++)
+        insertTail(list, newInt(i));
+    freedRecords = 0;
+    removeTop(list);
+    resetList(list);
+    assert_int_equal(freedRecords, a);
+    assert_null(list->head);
+    assert_int_equal(listLength(list), 0);
+
+    // an index survives, emptied
+    list->freeData = NULL;
+    int value = 7;
+    insertTop(list, &value);
+    assert_true(attachHashIndex(list, &intHash, &intDifference));
+    resetList(list);
+    assert_non_null(list->index);
+    assert_null(findElement(list, &value, NULL));
+    insertTop(list, &value);
+    assert_ptr_equal(findElement(list, &value, NULL), &value);
+    destroyList(list);
+
+    // pooled lists give back their slabs
+    list = createListWithPool(8);
+    for (int i = 0; i < a; i++)
+        insertTop(list, newInt(i));
+    resetList(list);
+    assert_int_equal(shrinkPool(list), 0);
+    insertTop(list, newInt(1));
+    destroyList(list);
+}
+
+
+static void test_compactList(void **state)
+{
+    const int a = 1000;
+    assert_false(compactList(NULL));
+
+    LinkedList *list = createList();
+    assert_true(compactList(list));
+    assert_null(list->head);
+
+    // scatter the nodes by removing every other element
+    for (int i = 0; i < a; i++)
+        insertTail(list, newInt(i));
+    for (int i = 0; i < a; i += 2)
+        removeElement(list, &i, &intDifference);
+    assert_true(attachHashIndex(list, &intHash, &intDifference));
+    int *top = peekTop(list);
+
+    // the nodes end up in ascending address order, keeping their data
+    assert_true(compactList(list));
+    assert_non_null(list->pool);
+    assert_ptr_equal(peekTop(list), top);
+    assert_int_equal(assertSorted(list, &intDifference), a / 2);
+    for (ListNode *node = list->head; node->next; node = node->next)
+        assert_true((char *) node->next > (char *) node);
+
+    // the index follows the nodes to their new place
+    int value = a - 1;
+    assert_non_null(findElement(list, &value, NULL));
+    assert_true(removeElement(list, &value, NULL));
+    assert_null(findElement(list, &value, NULL));
+    assert_true(insertTop(list, newInt(-1)));
+    assert_int_equal(assertSorted(list, &intDifference), a / 2);
+    destroyList(list);
+
+    // pooled lists with individually allocated nodes are compacted too
+    list = createList();
+    LinkedList *other = createListWithPool(4);
+    for (int i = 0; i < a; i++)
+        insertTail(i % 2 ? list : other, newInt(i));
+    assert_true(mergeLists(list, other, &intDifference));
+    assert_true(compactList(list));
+    assert_int_equal(assertSorted(list, &intDifference), a);
+    assert_int_equal(shrinkPool(list), 0);
+    destroyList(list);
+
+    // inline elements are moved along with their nodes
+    list = createInlineList(sizeof(Record));
+    for (int i = 0; i < a; i++)
+    {
+        Record record = { i, i * 0.5, "record" };
+        insertTop(list, &record);
+    }
+    assert_true(compactList(list));
+    assert_int_equal(listLength(list), a);
+    int id = a - 1;
+    for (ListNode *node = list->head; node; node = node->next, id--)
+    {
+        Record *record = node->data;
+        assert_ptr_equal(record, node + 1);
+        assert_int_equal(record->id, id);
+        assert_string_equal(record->name, "record");
+    }
+    destroyList(list);
+}
+
+
+static void test_listCursor(void **state)
+{
+    const int a = 100;
+    ListCursor cursor;
+
+    // an empty list starts past the end, where elements are appended
+    LinkedList *list = createList();
+    initCursor(&cursor, list);
+    assert_null(cursorGet(&cursor));
+    assert_false(cursorNext(&cursor));
+    assert_false(cursorInsertAfter(&cursor, NULL));
+    cursorRemoveCurrent(&cursor);
+    assert_null(cursorUnlinkCurrent(&cursor));
+    for (int i = 0; i < a; i++)
+        assert_true(cursorInsertBefore(&cursor, newInt(i)));
+    assert_int_equal(assertSorted(list, &intDifference), a);
+    assert_int_equal(*(int *) peekTail(list), a - 1);
+    assert_true(attachHashIndex(list, &intHash, &intDifference));
+
+    // filter out the odd numbers in one pass
+    initCursor(&cursor, list);
+    while (cursorGet(&cursor))
+    {
+        if (*(int *) cursorGet(&cursor) % 2)
+            cursorRemoveCurrent(&cursor);
+        else
+            cursorNext(&cursor);
+    }
+    assert_int_equal(assertSorted(list, &intDifference), a / 2);
+    int value = 1;
+    assert_null(findElement(list, &value, NULL));
+
+    // then patch them back in after each even number
+    initCursor(&cursor, list);
+    while (cursorGet(&cursor))
+    {
+        assert_true(cursorInsertAfter(&cursor, newInt(*(int *) cursorGet(&cursor) + 1)));
+        cursorNext(&cursor);
+        cursorNext(&cursor);
+    }
+    assert_int_equal(assertSorted(list, &intDifference), a);
+    assert_non_null(findElement(list, &value, NULL));
+
+    // insert before the first element and unlink it again
+    initCursor(&cursor, list);
+    assert_true(cursorInsertBefore(&cursor, newInt(-1)));
+    assert_int_equal(*(int *) peekTop(list), -1);
+    assert_int_equal(*(int *) cursorGet(&cursor), 0);
+    int *zero = cursorUnlinkCurrent(&cursor);
+    assert_int_equal(*zero, 0);
+    free(zero);
+    assert_int_equal(*(int *) cursorGet(&cursor), 1);
+    assert_int_equal(assertSorted(list, &intDifference), a);
+
+    // removing the last element leaves the cursor past the end
+    while (cursorNext(&cursor))
+        if (*(int *) cursorGet(&cursor) == a - 1)
+            break;
+    cursorRemoveCurrent(&cursor);
+    assert_null(cursorGet(&cursor));
+    assert_int_equal(*(int *) peekTail(list), a - 2);
+    assert_int_equal(assertSorted(list, &intDifference), a - 1);
+    destroyList(list);
+
+    // inline elements can not outlive their node
+    list = createInlineList(sizeof(int));
+    insertTop(list, &value);
+    initCursor(&cursor, list);
+    assert_null(cursorUnlinkCurrent(&cursor));
+    assert_int_equal(*(int *) cursorGet(&cursor), value);
+    destroyList(list);
+}
+
+
+static void test_indexOperations(void **state)
+{
+    const int a = 200;
+    int model[2 * 200];
+    int length = 0;
+    unsigned seed = 12345;
+
+    assert_null(peekIndex(NULL, 0));
+    assert_false(insertIndex(NULL, NULL, 0));
+    assert_false(removeIndex(NULL, 0));
+
+    LinkedList *list = createList();
+    assert_null(peekIndex(list, 0));
+    assert_null(peekIndex(list, -1));
+    assert_false(removeIndex(list, 0));
+    assert_false(insertIndex(list, NULL, 1));
+    assert_false(insertIndex(list, NULL, -2));
+
+    // build 0..a-1 with sequential indexes, then check from both ends
+    for (int i = 0; i < a; i++)
+        assert_true(insertIndex(list, newInt(i), i));
+    for (int i = 0; i < a; i++)
+    {
+        assert_int_equal(*(int *) peekIndex(list, i), i);
+        assert_int_equal(*(int *) peekIndex(list, -1 - i), a - 1 - i);
+        model[length++] = i;
+    }
+    assert_null(peekIndex(list, a));
+    assert_null(peekIndex(list, -a - 1));
+    assert_int_equal(assertSorted(list, &intDifference), a);
+
+    // mix index operations with every other kind of change, checking the
+    // finger is never left pointing at the wrong index
+    for (int step = 0; step < 2000; step++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int choice = (seed >> 16) % 8;
+        int at = length ? (int) ((seed >> 4) % (length + 1)) : 0;
+        int value = step + a;
+
+        if (choice == 0 && length < 2 * a)
+        {
+            assert_true(insertIndex(list, newInt(value), at));
+            for (int i = length; i > at; i--)
+                model[i] = model[i - 1];
+            model[at] = value;
+            length++;
+        }
+        else if (choice == 1 && length < 2 * a)
+        {
+            // -1 inserts at the end, -length - 1 at the top
+            assert_true(insertIndex(list, newInt(value), at - length - 1));
+            for (int i = length; i > at; i--)
+                model[i] = model[i - 1];
+            model[at] = value;
+            length++;
+        }
+        else if (choice == 2 && at < length)
+        {
+            assert_true(removeIndex(list, at - length));
+            for (int i = at; i < length - 1; i++)
+                model[i] = model[i + 1];
+            length--;
+        }
+        else if (choice == 3 && length < 2 * a)
+        {
+            insertTop(list, newInt(value));
+            for (int i = length; i > 0; i--)
+                model[i] = model[i - 1];
+            model[0] = value;
+            length++;
+        }
+        else if (choice == 4 && length)
+        {
+            removeTail(list);
+            length--;
+        }
+        else if (choice == 5 && at < length)
+        {
+            removeElement(list, &model[at], &intDifference);
+            for (int i = at; i < length - 1; i++)
+                model[i] = model[i + 1];
+            length--;
+        }
+        else if (choice == 6 && length < 2 * a)
+        {
+            insertTail(list, newInt(value));
+            model[length++] = value;
+        }
+        else if (at < length)
+            assert_int_equal(*(int *) peekIndex(list, at), model[at]);
+
+        // a nearby lookup, then occasionally the whole list
+        if (length)
+        {
+            int near = (at + 1) % length;
+            assert_int_equal(*(int *) peekIndex(list, near), model[near]);
+        }
+        if (step % 100 == 0)
+        {
+            for (int i = 0; i < length; i++)
+                assert_int_equal(*(int *) peekIndex(list, i), model[i]);
+            assert_int_equal(listLength(list), length);
+        }
+    }
+
+    // reordering the list forgets the finger
+    sortList(list, &intDifference);
+    for (int i = 0; i < length; i++)
+        for (int j = i + 1; j < length; j++)
+            if (model[j] < model[i])
+            {
+                int swap = model[i];
+                model[i] = model[j];
+                model[j] = swap;
+            }
+    for (int i = length - 1; i >= 0; i--)
+        assert_int_equal(*(int *) peekIndex(list, i), model[i]);
+
+    destroyList(list);
+}
+
+
+static void test_listStats(void **state)
+{
+    const int a = 100;
+    ListStats stats;
+    LinkedList *list = createList();
+
+#ifdef LL_STATS
+    for (int i = 0; i < a; i++)
+        insertTail(list, newInt(i));
+    assert_true(getListStats(list, &stats));
+    assert_int_equal(stats.allocations, a);
+    assert_int_equal(stats.frees, 0);
+    assert_int_equal(stats.length, a);
+    assert_int_equal(stats.peakLength, a);
+#ifdef DOUBLE_ENDED
+    assert_int_equal(stats.traversed, 0);
+#else
+    // every insertion walked to the end
+    assert_int_equal(stats.traversed, (a - 1) * (a - 2) / 2);
+#endif
+
+    for (int i = 0; i < a / 2; i++)
+        removeTop(list);
+    getListStats(list, &stats);
+    assert_int_equal(stats.frees, a / 2);
+    assert_int_equal(stats.length, a / 2);
+    assert_int_equal(stats.peakLength, a);
+
+    // resetting keeps the length
+    resetListStats(list);
+    getListStats(list, &stats);
+    assert_int_equal(stats.allocations, 0);
+    assert_int_equal(stats.traversed, 0);
+    assert_int_equal(stats.peakLength, a / 2);
+    peekIndex(list, 10);
+    getListStats(list, &stats);
+    assert_int_equal(stats.traversed, 10);
+
+    // removing the tail walks the list at most once
+    resetListStats(list);
+    removeTail(list);
+    getListStats(list, &stats);
+#ifdef DOUBLY_LINKED
+    assert_true(stats.traversed <= a / 2 - 1);
+#else
+    assert_int_equal(stats.traversed, a / 2 - 1);
+#endif
+
+    // the length is only counted once
+    unsigned long traversed = stats.traversed;
+    assert_int_equal(listLength(list), a / 2 - 1);
+    assert_int_equal(listLength(list), a / 2 - 1);
+    getListStats(list, &stats);
+#ifdef INSTANT_LENGTH
+    assert_int_equal(stats.traversed, traversed);
+#else
+    assert_int_equal(stats.traversed, traversed + a / 2 - 2);
+#endif
+    assert_int_equal(*(int *) peekIndex(list, -1), a - 2);
+
+    // freed lists are added to the totals
+    ListStats before;
+    getListStats(NULL, &before);
+    destroyList(list);
+    getListStats(NULL, &stats);
+    assert_int_equal(stats.destroyed, before.destroyed + 1);
+    assert_int_equal(stats.frees, before.frees + a / 2);
+    assert_true(stats.destroySeconds >= before.destroySeconds);
+    resetListStats(NULL);
+    getListStats(NULL, &stats);
+    assert_int_equal(stats.destroyed, 0);
+#else
+    // nothing is counted unless enabled
+    insertTop(list, newInt(a));
+    assert_false(getListStats(list, &stats));
+    assert_int_equal(stats.allocations, 0);
+    assert_false(getListStats(NULL, &stats));
+    resetListStats(list);
+    destroyList(list);
+#endif
+}
+
+
+typedef struct CountingHeap {
+    int allocations;
+    int releases;
+} CountingHeap;
+
+static void *countingAllocate(void *context, unsigned long size)
+{
+    ((CountingHeap *) context)->allocations++;
+    return malloc(size);
+}
+
+static void countingRelease(void *context, void *block)
+{
+    ((CountingHeap *) context)->releases++;
+    free(block);
+}
+
+typedef struct BumpHeap {
+    char *block;
+    unsigned long used;
+    unsigned long capacity;
+} BumpHeap;
+
+static void *bumpAllocate(void *context, unsigned long size)
+{
+    BumpHeap *heap = context;
+    size = (size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    if (heap->used + size > heap->capacity)
+        return NULL;
+    heap->used += size;
+    return heap->block + heap->used - size;
+}
+
+static void test_createListWithAllocator(void **state)
+{
+    const int a = 100;
+    CountingHeap counts = { 0, 0 };
+    ListAllocator counting = { &countingAllocate, &countingRelease, &counts };
+
+    // every node is allocated and released through the allocator
+    LinkedList *list = createListWithAllocator(&counting, &freeRecord);
+    assert_non_null(list);
+    assert_ptr_equal(list->allocator, &counting);
+    freedRecords = 0;
+    for (int i = 0; i < a; i++)
+        assert_true(insertTail(list, newInt(i)));
+    assert_int_equal(counts.allocations, a);
+    removeTop(list);
+    assert_int_equal(counts.releases, 1);
+    assert_int_equal(freedRecords, 1);
+
+    // including the slabs of a pool
+    DataPointer items[10];
+    for (int i = 0; i < 10; i++)
+        items[i] = newInt(a + i);
+    assert_true(insertArrayTail(list, items, 10));
+    assert_int_equal(counts.allocations, a + 1);
+    assert_true(compactList(list));
+    assert_int_equal(counts.allocations, a + 2);
+    assert_int_equal(assertSorted(list, &intDifference), a + 9);
+
+    // lists with different allocators are not merged
+    LinkedList *other = createList();
+    assert_false(mergeLists(list, other, &intDifference));
+    destroyList(other);
+
+    destroyList(list);
+    assert_int_equal(counts.releases, counts.allocations);
+    assert_int_equal(freedRecords, a + 10);
+
+    // an allocator without release is never asked to free anything
+    char buffer[4096];
+    BumpHeap heap = { buffer, 0, sizeof(buffer) };
+    ListAllocator bump = { &bumpAllocate, NULL, &heap };
+    list = createListWithAllocator(&bump, NULL);
+    int value = 1;
+    while (insertTop(list, &value))
+        ;
+    assert_true(heap.used > sizeof(buffer) - 2 * sizeof(ListNode));
+    ListNode *top = list->head;
+    assert_true((char *) top >= buffer && (char *) top < buffer + sizeof(buffer));
+    resetList(list);
+    assert_null(list->head);
+    destroyList(list);
+
+    // a NULL allocator uses malloc
+    list = createListWithAllocator(NULL, NULL);
+    assert_true(insertTop(list, &value));
+    destroyList(list);
+}
+
+
+static void test_unrolledList(void **state)
+{
+    const int a = 1001;
+    UnrolledList *list = createUnrolledList();
+    assert_non_null(list);
+    assert_null(peekUnrolledTop(list));
+    assert_null(peekUnrolledTail(list));
+    assert_false(insertUnrolledTop(NULL, NULL));
+    assert_false(insertUnrolledTail(NULL, NULL));
+
+    // build the list 0..a-1 from both ends
+    for (int i = a / 2; i >= 0; i--)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        assert_true(insertUnrolledTop(list, c));
+        assert_int_equal(*(int*)peekUnrolledTop(list), i);
+    }
+    for (int i = a / 2 + 1; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        assert_true(insertUnrolledTail(list, c));
+        assert_int_equal(*(int*)peekUnrolledTail(list), i);
+    }
+    assert_int_equal(unrolledListLength(list), a);
+
+    // the nodes should be packed full
+    int nodes = 0;
+    for (UnrolledNode *node = list->head; node; node = node->next)
+        nodes++;
+    assert_true(nodes <= a / UNROLLED_CAPACITY + 2);
+
+    int sum = 0;
+    reduceUnrolledList(list, &reducer, &sum);
+    assert_int_equal(sum, a * (a - 1) / 2);
+
+    // remove from both ends checking the remaining ends each time
+    for (int i = 0; i < a / 2; i++)
+    {
+        removeUnrolledTop(list);
+        removeUnrolledTail(list);
+        assert_int_equal(*(int*)peekUnrolledTop(list), i + 1);
+        assert_int_equal(*(int*)peekUnrolledTail(list), a - 2 - i);
+    }
+    assert_int_equal(unrolledListLength(list), 1);
+    removeUnrolledTail(list);
+    assert_null(list->head);
+    assert_null(list->tail);
+    assert_int_equal(unrolledListLength(list), 0);
+
+    destroyUnrolledList(list);
+    destroyUnrolledList(NULL);
+}
+
+
+static void test_unrolledList_merge(void **state)
+{
+    const int k = UNROLLED_CAPACITY;
+    const int sparse = k / 2 - 1;
+    UnrolledList *list = createUnrolledList();
+
+    // a full node followed by a node holding two elements
+    for (int i = 0; i < k + 2; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        insertUnrolledTail(list, c);
+    }
+    assert_ptr_not_equal(list->head, list->tail);
+
+    // once the first node is sparse it is merged with the second
+    for (int i = 0; i < k - sparse; i++)
+        removeUnrolledTop(list);
+    assert_ptr_equal(list->head, list->tail);
+    assert_int_equal(list->head->count, sparse + 2);
+    assert_int_equal(*(int*)peekUnrolledTop(list), k - sparse);
+    assert_int_equal(*(int*)peekUnrolledTail(list), k + 1);
+
+    // and the same from the other end
+    destroyUnrolledList(list);
+    list = createUnrolledList();
+    for (int i = 0; i < k + 2; i++)
+        insertUnrolledTop(list, malloc(sizeof(int)));
+    assert_ptr_not_equal(list->head, list->tail);
+    for (int i = 0; i < k - sparse; i++)
+        removeUnrolledTail(list);
+    assert_ptr_equal(list->head, list->tail);
+    assert_int_equal(unrolledListLength(list), sparse + 2);
+
+    destroyUnrolledList(list);
+}
+
+
+static void *countdownReducer(DataPointer data, void *carry)
+{
+    // each element must be one less than the last
+    assert_int_equal(*(int*)data, *(int*)carry);
+    (*(int*)carry)--;
+    return carry;
+}
+
+
+static void test_xorList(void **state)
+{
+    const int a = 1001;
+    XorList *list = createXorList();
+    assert_non_null(list);
+    assert_null(peekXorTop(list));
+    assert_null(peekXorTail(list));
+    assert_false(insertXorTop(NULL, NULL));
+    assert_false(insertXorTail(NULL, NULL));
+    removeXorTop(list);
+    removeXorTail(list);
+
+    // the nodes are no larger than those of a singly linked list
+    assert_true(sizeof(XorNode) <= 2 * sizeof(void *));
+
+    // build the list 0..a-1 from both ends
+    for (int i = a / 2; i >= 0; i--)
+    {
+        assert_true(insertXorTop(list, newInt(i)));
+        assert_int_equal(*(int*)peekXorTop(list), i);
+    }
+    for (int i = a / 2 + 1; i < a; i++)
+    {
+        assert_true(insertXorTail(list, newInt(i)));
+        assert_int_equal(*(int*)peekXorTail(list), i);
+    }
+    assert_int_equal(xorListLength(list), a);
+
+    // traverse in both directions
+    int sum = 0;
+    reduceXorList(list, &reducer, &sum);
+    assert_int_equal(sum, a * (a - 1) / 2);
+    int expected = a - 1;
+    reduceXorListReverse(list, &countdownReducer, &expected);
+    assert_int_equal(expected, -1);
+
+    // remove from both ends checking the remaining ends each time
+    for (int i = 0; i < a / 2; i++)
+    {
+        removeXorTop(list);
+        removeXorTail(list);
+        assert_int_equal(*(int*)peekXorTop(list), i + 1);
+        assert_int_equal(*(int*)peekXorTail(list), a - 2 - i);
+    }
+    assert_int_equal(xorListLength(list), 1);
+    assert_ptr_equal(list->head, list->tail);
+    removeXorTop(list);
+    assert_null(list->head);
+    assert_null(list->tail);
+    assert_int_equal(xorListLength(list), 0);
+    assert_int_equal(reduceXorListReverse(list, &countdownReducer, &expected), &expected);
+
+    // a reversed list is still linked correctly after removals
+    for (int i = 0; i < 10; i++)
+        insertXorTop(list, newInt(i));
+    removeXorTail(list);
+    expected = 9;
+    reduceXorList(list, &countdownReducer, &expected);
+    assert_int_equal(expected, 0);
+
+    destroyXorList(list);
+    destroyXorList(NULL);
+}
+
+
+static void test_createCompactList(void **state)
+{
+    const int a = 1001;
+    assert_null(createCompactList(0, 0));
+    assert_false(insertCompactTop(NULL, NULL));
+    assert_false(insertCompactTail(NULL, NULL));
+
+    // start small so the arrays have to grow
+    CompactList *list = createCompactList(sizeof(Record), 1);
+    assert_non_null(list);
+    assert_null(peekCompactTop(list));
+    assert_null(peekCompactTail(list));
+    removeCompactTop(list);
+    removeCompactTail(list);
+
+    // build the list 0..a-1 from both ends, copying from the stack
+    for (int i = a / 2; i >= 0; i--)
+    {
+        Record record = { i, i * 0.5, "record" };
+        assert_true(insertCompactTop(list, &record));
+        assert_int_equal(((Record *) peekCompactTop(list))->id, i);
+    }
+    for (int i = a / 2 + 1; i < a; i++)
+    {
+        Record record = { i, i * 0.5, "record" };
+        assert_true(insertCompactTail(list, &record));
+        assert_int_equal(((Record *) peekCompactTail(list))->id, i);
+    }
+    assert_int_equal(compactListLength(list), a);
+    assert_true(list->capacity >= a);
+
+    long sum = 0;
+    reduceCompactList(list, &recordReducer, &sum);
+    assert_int_equal(sum, a * (a - 1) / 2);
+
+    // removed nodes are reused before the arrays grow again
+    uint32_t capacity = list->capacity;
+    for (int i = 0; i < a / 2; i++)
+    {
+        removeCompactTop(list);
+        removeCompactTail(list);
+        assert_int_equal(((Record *) peekCompactTop(list))->id, i + 1);
+        assert_int_equal(((Record *) peekCompactTail(list))->id, a - 2 - i);
+    }
+    assert_int_equal(compactListLength(list), 1);
+    for (int i = 0; i < a - 1; i++)
+    {
+        Record record = { -i, 0, "reused" };
+        insertCompactTop(list, &record);
+    }
+    assert_int_equal(list->capacity, capacity);
+    assert_int_equal(list->used, a);
+    assert_int_equal(((Record *) peekCompactTail(list))->id, a / 2);
+    assert_string_equal(((Record *) peekCompactTop(list))->name, "reused");
+
+    while (compactListLength(list))
+        removeCompactTail(list);
+    assert_int_equal(list->head, COMPACT_NONE);
+    assert_int_equal(list->tail, COMPACT_NONE);
+    assert_null(peekCompactTop(list));
+
+    destroyCompactList(list);
+    destroyCompactList(NULL);
+}
+
+
+#define INT_COMPARE(a, b) ((a) < (b) ? -1 : (a) > (b))
+#define RECORD_COMPARE(a, b) INT_COMPARE((a).id, (b).id)
+
+LL_DEFINE(IntList, int, INT_COMPARE)
+LL_DEFINE(RecordList, Record, RECORD_COMPARE)
+
+static void *typedSumReducer(int *value, void *carry)
+{
+    *(long*)carry += *value;
+    return carry;
+}
+
+static void test_typedList(void **state)
+{
+    const int a = 1000;
+    IntList list;
+    IntListInit(&list);
+    assert_null(IntListPeekTop(&list));
+    assert_null(IntListPeekTail(&list));
+    assert_false(IntListRemoveTop(&list, NULL));
+
+    // values are stored in the nodes, in a scrambled order
+    for (int i = 0; i < a; i++)
+        assert_true(IntListInsertTop(&list, (i * 7919) % a));
+    assert_int_equal(IntListLength(&list), a);
+    assert_non_null(IntListFind(&list, 17));
+    assert_null(IntListFind(&list, a));
+
+    long sum = 0;
+    IntListReduce(&list, &typedSumReducer, &sum);
+    assert_int_equal(sum, a * (a - 1) / 2);
+
+    IntListSort(&list);
+    int expected = 0;
+    IntListNode *node;
+    LL_FOR_EACH(IntList, node, &list)
+        assert_int_equal(node->value, expected++);
+    assert_int_equal(*IntListPeekTail(&list), a - 1);
+    assert_ptr_equal(list.tail->next, NULL);
+
+    // sorted insertion keeps the order and the tail
+    assert_true(IntListInsertSorted(&list, -1));
+    assert_true(IntListInsertSorted(&list, a));
+    assert_true(IntListInsertSorted(&list, a / 2));
+    assert_int_equal(*IntListPeekTop(&list), -1);
+    assert_int_equal(*IntListPeekTail(&list), a);
+    int previous = -2;
+    LL_FOR_EACH(IntList, node, &list)
+    {
+        assert_true(node->value >= previous);
+        previous = node->value;
+    }
+
+    int value;
+    assert_true(IntListRemoveTop(&list, &value));
+    assert_int_equal(value, -1);
+    assert_int_equal(IntListLength(&list), a + 2);
+    IntListClear(&list);
+    assert_null(list.head);
+    assert_int_equal(IntListLength(&list), 0);
+
+    // structs are copied whole, and sorting is stable
+    RecordList records;
+    RecordListInit(&records);
+    for (int i = 0; i < a; i++)
+    {
+        Record record = { i % 10, i, "record" };
+        assert_true(RecordListInsertTail(&records, record));
+    }
+    RecordListSort(&records);
+    Record *last = NULL;
+    RecordListNode *current;
+    LL_FOR_EACH(RecordList, current, &records)
+    {
+        if (last && last->id == current->value.id)
+            assert_true(last->value < current->value.value);
+        last = &current->value;
+    }
+    Record needle = { 9, 0, "" };
+    assert_int_equal(RecordListFind(&records, needle)->value, 9);
+    assert_string_equal(RecordListPeekTop(&records)->name, "record");
+    while (RecordListRemoveTop(&records, NULL))
+        ;
+    assert_null(records.tail);
+}
+
+
+static int isEven(DataPointer data, void *context)
+{
+    (void) context;
+    return *(int *) data % 2 == 0;
+}
+
+static DataPointer scaleInt(DataPointer data, void *factor)
+{
+    return newInt(*(int *) data * *(int *) factor);
+}
+
+static void freeInt(DataPointer data)
+{
+    free(data);
+}
+
+static void countVisit(DataPointer data, void *count)
+{
+    (void) data;
+    ++*(int *) count;
+}
+
+static void *pipelineSumReducer(DataPointer data, void *carry)
+{
+    *(long *) carry += *(int *) data;
+    return carry;
+}
+
+static void test_pipeline(void **state)
+{
+    const int a = 100;
+    LinkedList *list = createList();
+    for (int i = 0; i < a; i++)
+        insertTail(list, newInt(i));
+
+    // an empty pipeline outputs the list unchanged
+    Pipeline pipeline;
+    initPipeline(&pipeline, list);
+    assert_int_equal(runPipeline(&pipeline), a);
+
+    // stages run in order, and nothing is visited when the pipeline is built
+    int visited = 0, kept = 0, factor = 3;
+    assert_true(pipelineForEach(&pipeline, &countVisit, &visited));
+    assert_true(pipelineFilter(&pipeline, &isEven, NULL));
+    assert_true(pipelineForEach(&pipeline, &countVisit, &kept));
+    assert_int_equal(visited, 0);
+    long sum = 0;
+    reducePipeline(&pipeline, &pipelineSumReducer, &sum);
+    assert_int_equal(sum, a / 2 * (a / 2 - 1));
+    assert_int_equal(visited, a);
+    assert_int_equal(kept, a / 2);
+
+    // a full take stage stops the traversal
+    visited = kept = 0;
+    assert_true(pipelineTake(&pipeline, 5));
+    assert_true(pipelineMap(&pipeline, &scaleInt, &factor));
+    LinkedList *output = collectPipeline(&pipeline, &freeInt);
+    assert_non_null(output);
+    assert_int_equal(listLength(output), 5);
+    assert_int_equal(visited, 9);
+    assert_int_equal(kept, 5);
+    for (int i = 0; i < 5; i++)
+        assert_int_equal(*(int *) peekIndex(output, i), i * 6);
+    assert_int_equal(*(int *) peekTail(output), 24);
+    destroyList(output);
+
+    // a pipeline can be run again, and an empty take visits nothing
+    output = collectPipeline(&pipeline, &freeInt);
+    assert_int_equal(listLength(output), 5);
+    destroyList(output);
+    visited = 0;
+    initPipeline(&pipeline, list);
+    assert_true(pipelineForEach(&pipeline, &countVisit, &visited));
+    assert_true(pipelineTake(&pipeline, 0));
+    assert_int_equal(runPipeline(&pipeline), 0);
+    assert_int_equal(visited, 0);
+
+    // collecting without a map shares the elements with the source
+    initPipeline(&pipeline, list);
+    pipelineFilter(&pipeline, &isEven, NULL);
+    output = collectPipeline(&pipeline, NULL);
+    assert_int_equal(listLength(output), a / 2);
+    assert_ptr_equal(peekTop(output), peekTop(list));
+    destroyList(output);
+
+    // the number of stages is bounded
+    initPipeline(&pipeline, list);
+    for (int i = 0; i < PIPELINE_MAX_STAGES; i++)
+        assert_true(pipelineTake(&pipeline, a));
+    assert_false(pipelineTake(&pipeline, a));
+    assert_false(pipelineMap(&pipeline, NULL, NULL));
+    assert_int_equal(runPipeline(&pipeline), a);
+    assert_int_equal(runPipeline(NULL), 0);
+    assert_null(collectPipeline(NULL, NULL));
+
+    destroyList(list);
+}
+
+
+typedef struct KeyedRecord {
+    int64_t key;
+    int value;
+} KeyedRecord;
+
+static KeyedRecord *newKeyedRecord(int64_t key, int value)
+{
+    KeyedRecord *record = malloc(sizeof(KeyedRecord));
+    record->key = key;
+    record->value = value;
+    return record;
+}
+
+static void *keyedValueReducer(DataPointer data, void *carry)
+{
+    *(long *) carry += ((KeyedRecord *) data)->value;
+    return carry;
+}
+
+static void test_keyedList(void **state)
+{
+    const int a = 1000;
+    KeyedList *list = createKeyedList();
+    assert_null(peekKeyedTop(list));
+    assert_null(findKeyedElement(list, 0));
+    assert_int_equal(countKeyedMatching(list, 0), 0);
+    assert_false(insertKeyedTail(list, NULL));
+
+    // keys differ only in their upper half every so often, which SSE2 must not
+    // mistake for a match, and every tenth key repeats
+    for (int i = 0; i < a; i++)
+    {
+        int64_t key = i % 10 == 9 ? -1 : ((int64_t) (i % 3) << 32) + i;
+        assert_true(insertKeyedTail(list, newKeyedRecord(key, i)));
+    }
+    assert_true(insertKeyedTop(list, newKeyedRecord(-1, -1)));
+    assert_int_equal(keyedListLength(list), a + 1);
+    assert_int_equal(((KeyedRecord *) peekKeyedTop(list))->value, -1);
+
+    // every search gives the same answers, and automatic is the widest
+    assert_true(setKeyedSearch(KEYED_SEARCH_SCALAR));
+    assert_int_equal(getKeyedSearch(), KEYED_SEARCH_SCALAR);
+    KeyedSearch modes[] = { KEYED_SEARCH_SCALAR, KEYED_SEARCH_SSE2, KEYED_SEARCH_AVX2 };
+    for (int m = 0; m < 3; m++)
+    {
+        if (!setKeyedSearch(modes[m]))
+        {
+            assert_int_not_equal(getKeyedSearch(), modes[m]);
+            continue;
+        }
+        for (int i = 0; i < a; i++)
+        {
+            KeyedRecord *found = findKeyedElement(list, ((int64_t) (i % 3) << 32) + i);
+            if (i % 10 == 9)
+                assert_true(found == NULL || found->value != i);
+            else
+                assert_int_equal(found->value, i);
+        }
+        assert_null(findKeyedElement(list, 2));
+        assert_null(findKeyedElement(list, (int64_t) 1 << 32));
+        assert_int_equal(((KeyedRecord *) findKeyedElement(list, -1))->value, -1);
+        assert_int_equal(countKeyedMatching(list, -1), a / 10 + 1);
+        assert_int_equal(countKeyedMatching(list, 0), 1);
+        assert_int_equal(countKeyedMatching(list, 2), 0);
+    }
+    assert_true(setKeyedSearch(KEYED_SEARCH_AUTO));
+    assert_int_not_equal(getKeyedSearch(), KEYED_SEARCH_AUTO);
+
+    long sum = 0;
+    reduceKeyedList(list, &keyedValueReducer, &sum);
+    assert_int_equal(sum, a * (a - 1) / 2 - 1);
+
+    // removing from the top drops emptied chunks
+    for (int i = 0; i < a; i++)
+        removeKeyedTop(list);
+    assert_int_equal(keyedListLength(list), 1);
+    assert_ptr_equal(list->head, list->tail);
+    assert_int_equal(((KeyedRecord *) peekKeyedTop(list))->value, a - 1);
+    removeKeyedTop(list);
+    assert_null(list->head);
+    assert_null(list->tail);
+    assert_true(insertKeyedTop(list, newKeyedRecord(7, 7)));
+    assert_int_equal(countKeyedMatching(list, 7), 1);
+
+    // chunks started at the top fill from the back
+    for (int i = 0; i < 3 * KEYED_CHUNK_KEYS; i++)
+        assert_true(insertKeyedTop(list, newKeyedRecord(i, i)));
+    assert_int_equal(((KeyedRecord *) peekKeyedTop(list))->value, 3 * KEYED_CHUNK_KEYS - 1);
+    for (int i = 0; i < 3 * KEYED_CHUNK_KEYS; i++)
+        assert_int_equal(((KeyedRecord *) findKeyedElement(list, i))->value, i);
+    assert_int_equal(countKeyedMatching(list, 7), 2);
+    for (int i = 0; i < 2 * KEYED_CHUNK_KEYS + 1; i++)
+        removeKeyedTop(list);
+    assert_int_equal(((KeyedRecord *) peekKeyedTop(list))->value, KEYED_CHUNK_KEYS - 2);
+    assert_null(findKeyedElement(list, KEYED_CHUNK_KEYS - 1));
+    assert_true(insertKeyedTail(list, newKeyedRecord(-5, -5)));
+    assert_int_equal(((KeyedRecord *) findKeyedElement(list, -5))->value, -5);
+    assert_int_equal(keyedListLength(list), KEYED_CHUNK_KEYS + 1);
+
+    destroyKeyedList(list);
+    destroyKeyedList(NULL);
+}
+
+
+static void *sumIdentity(void)
+{
+    long *sum = malloc(sizeof(long));
+    *sum = 0;
+    return sum;
+}
+
+
+static void *sumReducer(DataPointer data, void *carry)
+{
+    *(long*)carry += *(int*)data;
+    return carry;
+}
+
+
+static void *sumCombiner(void *left, void *right)
+{
+    *(long*)left += *(long*)right;
+    free(right);
+    return left;
+}
+
+
+static void *concatIdentity(void)
+{
+    long *digits = malloc(sizeof(long));
+    *digits = 0;
+    return digits;
+}
+
+
+static void *concatReducer(DataPointer data, void *carry)
+{
+    *(long*)carry = *(long*)carry * 10 + *(int*)data;
+    return carry;
+}
+
+
+static void *concatCombiner(void *left, void *right)
+{
+    // shift the left digits along by the number of digits on the right
+    long shift = 1;
+    for (long r = *(long*)right; r > 0; r /= 10)
+        shift *= 10;
+    *(long*)left = *(long*)left * shift + *(long*)right;
+    free(right);
+    return left;
+}
+
+
+static void test_reduceListParallel(void **state)
+{
+    const int a = 10007;
+    LinkedList *list = createList();
+
+    // an empty list reduces to the identity
+    long *actual = reduceListParallel(list, &sumReducer, &sumCombiner, &sumIdentity, 4);
+    assert_int_equal(*actual, 0);
+    free(actual);
+
+    for (int i = 0; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        insertTail(list, c);
+    }
+
+    // any number of threads should give the same result
+    unsigned int threads[] = { 0, 1, 2, 3, 8, 64 };
+    for (int t = 0; t < 6; t++)
+    {
+        actual = reduceListParallel(list, &sumReducer, &sumCombiner, &sumIdentity, threads[t]);
+        assert_int_equal(*actual, (long) a * (a - 1) / 2);
+        free(actual);
+    }
+
+    destroyList(list);
+}
+
+
+static void test_reduceListParallel_order(void **state)
+{
+    LinkedList *list = createList();
+
+    // digits 1..9 so the order of the combined segments can be checked
+    for (int i = 1; i < 10; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        insertTail(list, c);
+    }
+
+    for (unsigned int t = 1; t <= 12; t++)
+    {
+        long *actual = reduceListParallel(list, &concatReducer, &concatCombiner, &concatIdentity, t);
+        assert_int_equal(*actual, 123456789);
+        free(actual);
+    }
+
+    destroyList(list);
+}
+
+
+static void test_list2Array(void **state)
+{
+    const int a = 50;
+    assert_null(list2Array(NULL));
+    destroyArray(NULL, NULL);
+
+    // an empty list gives an empty array
+    ArrayList *array = list2Array(createList());
+    assert_non_null(array);
+    assert_int_equal(array->length, 0);
+    destroyArray(array, NULL);
+
+    LinkedList *list = createListWithPool(8);
+    for (int i = 0; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        insertTail(list, c);
+    }
+
+    // the list is freed and the array takes ownership of the data
+    array = list2Array(list);
+    assert_non_null(array);
+    assert_int_equal(array->length, a);
+    for (int i = 0; i < a; i++)
+        assert_int_equal(*(int *) array->elements[i], i);
+
+    freedRecords = 0;
+    destroyArray(array, &freeRecord);
+    assert_int_equal(freedRecords, a);
+
+    // inline elements are copied into the array's block
+    list = createInlineList(sizeof(Record));
+    for (int i = 0; i < a; i++)
+    {
+        Record record = { i, 0, "inline" };
+        insertTop(list, &record);
+    }
+    array = list2Array(list);
+    assert_int_equal(array->elementSize, sizeof(Record));
+    for (int i = 0; i < a; i++)
+    {
+        Record *record = array->elements[i];
+        assert_int_equal(record->id, a - 1 - i);
+        assert_string_equal(record->name, "inline");
+    }
+    destroyArray(array, &freeRecord);
+    assert_int_equal(freedRecords, a);
+
+    // an array from a list that does not own its data does not free it
+    int unowned[50];
+    list = createListWithAllocator(NULL, NULL);
+    for (int i = 0; i < a; i++)
+    {
+        unowned[i] = i;
+        insertTail(list, &unowned[i]);
+    }
+    array = list2Array(list);
+    assert_null(array->freeData);
+    assert_int_equal(*(int *) array->elements[a - 1], a - 1);
+    destroyArray(array, NULL);
+
+    list = createListWithAllocator(NULL, NULL);
+    insertTail(list, &unowned[0]);
+    FrozenList *frozen = freezeList(list);
+    destroyFrozenList(frozen, NULL);
+
+    // a custom freeData is kept by the array
+    list = createListWithAllocator(NULL, &freeRecord);
+    for (int i = 0; i < a; i++)
+        insertTail(list, malloc(sizeof(int)));
+    freedRecords = 0;
+    destroyArray(list2Array(list), NULL);
+    assert_int_equal(freedRecords, a);
+}
+
+
+static void test_frozenList(void **state)
+{
+    const int a = 100;
+    assert_null(freezeList(NULL));
+    assert_int_equal(frozenListLength(NULL), 0);
+    assert_null(peekFrozenIndex(NULL, 0));
+
+    LinkedList *list = createList();
+    for (int i = 0; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        insertTail(list, c);
+    }
+    long expected = 0;
+    reduceList(list, &sumReducer, &expected);
+
+    FrozenList *frozen = freezeList(list);
+    assert_non_null(frozen);
+    assert_int_equal(frozenListLength(frozen), a);
+    assert_int_equal(*(int *) peekFrozenTop(frozen), 0);
+    assert_int_equal(*(int *) peekFrozenTail(frozen), a - 1);
+
+    // constant time indexing from either end
+    for (int i = 0; i < a; i++)
+    {
+        assert_int_equal(*(int *) peekFrozenIndex(frozen, i), i);
+        assert_int_equal(*(int *) peekFrozenIndex(frozen, -i - 1), a - 1 - i);
+    }
+    assert_null(peekFrozenIndex(frozen, a));
+    assert_null(peekFrozenIndex(frozen, -a - 1));
+
+    // scanning gives the same result as the list it came from
+    long sum = 0;
+    reduceFrozenList(frozen, &sumReducer, &sum);
+    assert_int_equal(sum, expected);
+
+    destroyFrozenList(frozen, NULL);
+
+    // an empty frozen list has nothing to peek
+    frozen = freezeList(createList());
+    assert_null(peekFrozenTop(frozen));
+    assert_null(peekFrozenTail(frozen));
+    destroyFrozenList(frozen, NULL);
+}
+
+
+static void test_skipList(void **state)
+{
+    const int a = 1000;
+    assert_null(createSkipList(NULL));
+    assert_false(insertSkipSorted(NULL, NULL));
+    assert_null(findSkipElement(NULL, NULL));
+    assert_int_equal(skipListLength(NULL), 0);
+
+    SkipList *list = createSkipList(&keyDifference);
+    assert_non_null(list);
+    assert_null(peekSkipTop(list));
+    assert_null(peekSkipTail(list));
+
+    // keys 0 to a/2 - 1, each twice, inserted out of order
+    for (int i = 0; i < a; i++)
+        assert_true(insertSkipSorted(list, newInt((i * 7919) % (a / 2) * 1000 + i)));
+    assert_int_equal(skipListLength(list), a);
+    assert_true(list->levels > 1);
+
+    // the bottom level is an ordinary sorted list
+    assert_int_equal(assertSorted(&list->base, &keyDifference), a);
+    long sum = 0;
+    reduceSkipList(list, &sumReducer, &sum);
+    long expected = 0;
+    reduceList(&list->base, &sumReducer, &expected);
+    assert_int_equal(sum, expected);
+    assert_int_equal(*(int *) peekSkipTop(list) / 1000, 0);
+    assert_int_equal(*(int *) peekSkipTail(list) / 1000, a / 2 - 1);
+
+    // every key is found, and equal keys keep their insertion order
+    for (int key = 0; key < a / 2; key++)
+    {
+        int needle = key * 1000;
+        int *found = findSkipElement(list, &needle);
+        assert_non_null(found);
+        assert_int_equal(*found / 1000, key);
+    }
+    for (ListNode *node = list->base.head; node->next; node = node->next)
+        if (keyDifference(node->data, node->next->data) == 0)
+            assert_true(*(int *) node->data % 1000 < *(int *) node->next->data % 1000);
+
+    int missing = a * 1000;
+    assert_null(findSkipElement(list, &missing));
+    assert_false(removeSkipElement(list, &missing));
+
+    // remove one of each pair, then the rest from the largest down
+    for (int key = 0; key < a / 2; key++)
+    {
+        int needle = key * 1000;
+        assert_true(removeSkipElement(list, &needle));
+        assert_non_null(findSkipElement(list, &needle));
+    }
+    assert_int_equal(assertSorted(&list->base, &keyDifference), a / 2);
+#ifdef LL_STATS
+    // the embedded list counts the skip list's nodes
+    ListStats stats;
+    assert_true(getListStats(&list->base, &stats));
+    assert_int_equal(stats.allocations, a);
+    assert_int_equal(stats.frees, a / 2);
+    assert_int_equal(stats.length, a / 2);
+    assert_int_equal(stats.peakLength, a);
+#endif
+    for (int key = a / 2 - 1; key >= 0; key--)
+    {
+        int needle = key * 1000;
+        assert_true(removeSkipElement(list, &needle));
+        assert_null(findSkipElement(list, &needle));
+        if (key)
+            assert_int_equal(*(int *) peekSkipTail(list) / 1000, key - 1);
+    }
+    assert_int_equal(skipListLength(list), 0);
+    assert_int_equal(list->levels, 1);
+    assert_int_equal(assertSorted(&list->base, &keyDifference), 0);
+
+    // the list can be refilled and destroyed with elements in it
+    for (int i = 0; i < a; i++)
+        insertSkipSorted(list, newInt(i));
+    assert_int_equal(listLength(&list->base), a);
+    assert_int_equal(*(int *) peekIndex(&list->base, -1), a - 1);
+#ifdef LL_STATS
+    // destroying the list adds it to the totals
+    ListStats before;
+    getListStats(NULL, &before);
+    destroySkipList(list);
+    getListStats(NULL, &stats);
+    assert_int_equal(stats.destroyed, before.destroyed + 1);
+    assert_int_equal(stats.allocations, before.allocations + 2 * a);
+    assert_int_equal(stats.frees, before.frees + 2 * a);
+#else
+    destroySkipList(list);
+#endif
+    destroySkipList(NULL);
+
+    // elements are released through freeData, or not at all when it is NULL
+    list = createSkipList(&keyDifference);
+    list->base.freeData = &freeRecord;
+    freedRecords = 0;
+    for (int i = 0; i < 10; i++)
+        insertSkipSorted(list, newInt(i * 1000));
+    int needle = 0;
+    assert_true(removeSkipElement(list, &needle));
+    destroySkipList(list);
+    assert_int_equal(freedRecords, 10);
+
+    int unowned[10];
+    list = createSkipList(&keyDifference);
+    list->base.freeData = NULL;
+    for (int i = 0; i < 10; i++)
+    {
+        unowned[i] = i * 1000;
+        insertSkipSorted(list, &unowned[i]);
+    }
+    assert_true(removeSkipElement(list, &unowned[3]));
+    destroySkipList(list);
+}
+
+
+static void test_popTop(void **state)
+{
+    LinkedList *list = createList();
+    assert_null(popTop(NULL));
+    assert_null(popTop(list));
+
+    int *a = malloc(sizeof(int));
+    int *b = malloc(sizeof(int));
+    insertTail(list, a);
+    insertTail(list, b);
+
+    // the data is handed back rather than freed
+    assert_ptr_equal(popTop(list), a);
+    assert_int_equal(listLength(list), 1);
+    assert_ptr_equal(popTop(list), b);
+    assert_null(peekTail(list));
+    assert_int_equal(listLength(list), 0);
+
+    free(a);
+    free(b);
+    destroyList(list);
+}
+
+
+static void test_concurrentStack(void **state)
+{
+    const int a = 1001;
+    ConcurrentStack *stack = createConcurrentStack(0);
+    assert_non_null(stack);
+    assert_null(popConcurrentTop(stack));
+    assert_false(insertConcurrentTop(NULL, NULL));
+    assert_null(popConcurrentTop(NULL));
+
+    for (int i = 0; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        assert_true(insertConcurrentTop(stack, c));
+    }
+
+    // elements come back in reverse order
+    for (int i = a - 1; i >= a / 2; i--)
+    {
+        int *c = popConcurrentTop(stack);
+        assert_int_equal(*c, i);
+        free(c);
+    }
+
+    // removed nodes are reused before new ones
+    uint32_t allocated = stack->allocated;
+    for (int i = 0; i < a / 2; i++)
+        insertConcurrentTop(stack, malloc(sizeof(int)));
+    assert_int_equal(stack->allocated, allocated);
+
+    removeConcurrentTop(stack);
+
+    // destroying frees the remaining data
+    destroyConcurrentStack(stack);
+    destroyConcurrentStack(NULL);
+}
+
+
+#define STACK_THREADS 8
+#define STACK_ITEMS 20000
+
+static int stackValues[STACK_THREADS * STACK_ITEMS];
+static int stackSeen[STACK_THREADS * STACK_ITEMS];
+static int stackNext;
+
+static void *stackWorker(void *argument)
+{
+    ConcurrentStack *stack = argument;
+
+    // interleave pushes and pops so threads contend on the top
+    for (int i = 0; i < STACK_ITEMS; i++)
+    {
+        int index = __atomic_fetch_add(&stackNext, 1, __ATOMIC_RELAXED);
+        insertConcurrentTop(stack, &stackValues[index]);
+        if (i % 2)
+        {
+            int *value = popConcurrentTop(stack);
+            if (value)
+                __atomic_fetch_add(&stackSeen[*value], 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    return NULL;
+}
+
+static void test_concurrentStack_threads(void **state)
+{
+    pthread_t threads[STACK_THREADS];
+    ConcurrentStack *stack = createConcurrentStack(STACK_THREADS * STACK_ITEMS);
+    assert_non_null(stack);
+
+    stackNext = 0;
+    for (int i = 0; i < STACK_THREADS * STACK_ITEMS; i++)
+    {
+        stackValues[i] = i;
+        stackSeen[i] = 0;
+    }
+
+    for (int i = 0; i < STACK_THREADS; i++)
+        assert_int_equal(pthread_create(&threads[i], NULL, &stackWorker, stack), 0);
+    for (int i = 0; i < STACK_THREADS; i++)
+        pthread_join(threads[i], NULL);
+
+    // drain what is left then check every value came out exactly once
+    int *value;
+    while ((value = popConcurrentTop(stack)))
+        stackSeen[*value]++;
+    for (int i = 0; i < STACK_THREADS * STACK_ITEMS; i++)
+        assert_int_equal(stackSeen[i], 1);
+
+    destroyConcurrentStack(stack);
+}
+
+
+static void test_concurrentQueue(void **state)
+{
+    const int a = 1001;
+    ConcurrentQueue *queue = createConcurrentQueue();
+    assert_non_null(queue);
+    assert_null(dequeue(queue));
+    assert_false(enqueue(NULL, NULL));
+    assert_null(dequeue(NULL));
+
+    for (int i = 0; i < a; i++)
+    {
+        int *c = malloc(sizeof(int));
+        *c = i;
+        assert_true(enqueue(queue, c));
+    }
+
+    // elements come back in the order they were inserted
+    for (int i = 0; i < a / 2; i++)
+    {
+        int *c = dequeue(queue);
+        assert_int_equal(*c, i);
+        free(c);
+    }
+
+    // destroying frees the remaining data
+    destroyConcurrentQueue(queue);
+    destroyConcurrentQueue(NULL);
+}
+
+
+#define QUEUE_THREADS 8
+#define QUEUE_ITEMS 20000
+
+static int queueValues[QUEUE_THREADS][QUEUE_ITEMS];
+static int queueSeen;
+static int queueNext;
+
+static void *queueWorker(void *argument)
+{
+    ConcurrentQueue *queue = argument;
+    int thread = __atomic_fetch_add(&queueNext, 1, __ATOMIC_RELAXED);
+
+    // each value encodes its producer and sequence number
+    for (int i = 0; i < QUEUE_ITEMS; i++)
+    {
+        queueValues[thread][i] = thread * QUEUE_ITEMS + i;
+        enqueue(queue, &queueValues[thread][i]);
+
+        int *value = dequeue(queue);
+        if (value)
+            __atomic_fetch_add(&queueSeen, 1, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+static void test_concurrentQueue_threads(void **state)
+{
+    pthread_t threads[QUEUE_THREADS];
+    ConcurrentQueue *queue = createConcurrentQueue();
+    assert_non_null(queue);
+    queueSeen = 0;
+    queueNext = 0;
+
+    for (int i = 0; i < QUEUE_THREADS; i++)
+        assert_int_equal(pthread_create(&threads[i], NULL, &queueWorker, queue), 0);
+    for (int i = 0; i < QUEUE_THREADS; i++)
+        pthread_join(threads[i], NULL);
+
+    // every value was removed by a worker, none twice
+    assert_int_equal(queueSeen, QUEUE_THREADS * QUEUE_ITEMS);
+    assert_null(dequeue(queue));
+
+    // values from a single producer come out in the order inserted
+    int last[QUEUE_THREADS];
+    for (int i = 0; i < QUEUE_THREADS; i++)
+    {
+        last[i] = -1;
+        for (int j = 0; j < 100; j++)
+            enqueue(queue, &queueValues[i][j]);
+    }
+    int *value;
+    while ((value = dequeue(queue)))
+    {
+        int producer = *value / QUEUE_ITEMS;
+        assert_true(*value % QUEUE_ITEMS > last[producer]);
+        last[producer] = *value % QUEUE_ITEMS;
+    }
+
+    destroyConcurrentQueue(queue);
+}
+
+
+typedef struct Item {
+    int value;
+    ListLink link;
+} Item;
+
+static void *itemReducer(ListLink *link, void *carry)
+{
+    int *sum = carry;
+    *sum = *sum * 10 + INTRUSIVE_ENTRY(link, Item, link)->value;
+    return carry;
+}
+
+static void test_intrusiveList(void **state)
+{
+    Item items[5];
+    IntrusiveList list;
+    initIntrusiveList(&list);
+    assert_null(peekIntrusiveTop(&list));
+    assert_null(popIntrusiveTail(&list));
+    assert_int_equal(intrusiveListLength(&list), 0);
+    assert_int_equal(intrusiveListLength(NULL), 0);
+
+    for (int i = 0; i < 5; i++)
+        items[i].value = i + 1;
+
+    // builds 2 1 3 5 4 without allocating
+    insertIntrusiveTop(&list, &items[0].link);
+    insertIntrusiveTop(&list, &items[1].link);
+    insertIntrusiveTail(&list, &items[2].link);
+    insertIntrusiveTail(&list, &items[3].link);
+    insertIntrusiveAfter(&list, &items[2].link, &items[4].link);
+    assert_int_equal(intrusiveListLength(&list), 5);
+    assert_ptr_equal(INTRUSIVE_ENTRY(peekIntrusiveTop(&list), Item, link), &items[1]);
+    assert_ptr_equal(INTRUSIVE_ENTRY(peekIntrusiveTail(&list), Item, link), &items[3]);
+
+    int sum = 0;
+    reduceIntrusiveList(&list, &itemReducer, &sum);
+    assert_int_equal(sum, 21354);
+
+    // unlinking from the middle is constant time and leaves the element intact
+    unlinkIntrusive(&list, &items[2].link);
+    assert_int_equal(items[2].value, 3);
+    assert_int_equal(intrusiveListLength(&list), 4);
+    sum = 0;
+    reduceIntrusiveList(&list, &itemReducer, &sum);
+    assert_int_equal(sum, 2154);
+
+    ListLink *link;
+    int count = 0;
+    INTRUSIVE_FOR_EACH(link, &list)
+        count++;
+    assert_int_equal(count, 4);
+
+    assert_ptr_equal(popIntrusiveTop(&list), &items[1].link);
+    assert_ptr_equal(popIntrusiveTail(&list), &items[3].link);
+    assert_ptr_equal(popIntrusiveTail(&list), &items[4].link);
+    assert_ptr_equal(popIntrusiveTail(&list), &items[0].link);
+    assert_null(popIntrusiveTop(&list));
+    assert_int_equal(intrusiveListLength(&list), 0);
+}
+
+
+/* cmocka's allocator is not thread-safe, but the concurrent stack and queue
+ * allocate from many threads at once. The makefile renames the allocator
+ * functions everywhere, so every call comes through these wrappers instead. */
+#undef _test_malloc
+#undef _test_calloc
+#undef _test_realloc
+#undef _test_free
+void *_test_malloc(size_t size, const char *file, int line);
+void *_test_calloc(size_t number, size_t size, const char *file, int line);
+void *_test_realloc(void *block, size_t size, const char *file, int line);
+void _test_free(void *block, const char *file, int line);
+
+static pthread_mutex_t allocatorLock = PTHREAD_MUTEX_INITIALIZER;
+
+void *lockedMalloc(size_t size, const char *file, int line)
+{
+    pthread_mutex_lock(&allocatorLock);
+    void *block = _test_malloc(size, file, line);
+    pthread_mutex_unlock(&allocatorLock);
+    return block;
+}
+
+void *lockedCalloc(size_t number, size_t size, const char *file, int line)
+{
+    pthread_mutex_lock(&allocatorLock);
+    void *block = _test_calloc(number, size, file, line);
+    pthread_mutex_unlock(&allocatorLock);
+    return block;
+}
+
+void *lockedRealloc(void *block, size_t size, const char *file, int line)
+{
+    pthread_mutex_lock(&allocatorLock);
+    block = _test_realloc(block, size, file, line);
+    pthread_mutex_unlock(&allocatorLock);
+    return block;
+}
+
+void lockedFree(void *block, const char *file, int line)
+{
+    pthread_mutex_lock(&allocatorLock);
+    _test_free(block, file, line);
+    pthread_mutex_unlock(&allocatorLock);
+}
+
+
 int main()
 {
     /* array of unit tests to run */
@@ -239,7 +2529,42 @@ int main()
         cmocka_unit_test(test_insertTail),
         cmocka_unit_test(test_removeTail),
         cmocka_unit_test(test_peekTop),
-        cmocka_unit_test(test_peekTail)
+        cmocka_unit_test(test_peekTail),
+        cmocka_unit_test(test_mixedEnds),
+        cmocka_unit_test(test_createListWithPool),
+        cmocka_unit_test(test_shrinkPool),
+        cmocka_unit_test(test_insertArray),
+        cmocka_unit_test(test_createInlineList),
+        cmocka_unit_test(test_sortList),
+        cmocka_unit_test(test_insertSorted),
+        cmocka_unit_test(test_mergeLists),
+        cmocka_unit_test(test_findElement),
+        cmocka_unit_test(test_hashIndex),
+        cmocka_unit_test(test_createListWithArena),
+        cmocka_unit_test(test_resetList),
+        cmocka_unit_test(test_compactList),
+        cmocka_unit_test(test_listCursor),
+        cmocka_unit_test(test_indexOperations),
+        cmocka_unit_test(test_listStats),
+        cmocka_unit_test(test_createListWithAllocator),
+        cmocka_unit_test(test_list2Array),
+        cmocka_unit_test(test_frozenList),
+        cmocka_unit_test(test_skipList),
+        cmocka_unit_test(test_unrolledList),
+        cmocka_unit_test(test_unrolledList_merge),
+        cmocka_unit_test(test_xorList),
+        cmocka_unit_test(test_createCompactList),
+        cmocka_unit_test(test_typedList),
+        cmocka_unit_test(test_pipeline),
+        cmocka_unit_test(test_keyedList),
+        cmocka_unit_test(test_reduceListParallel),
+        cmocka_unit_test(test_reduceListParallel_order),
+        cmocka_unit_test(test_popTop),
+        cmocka_unit_test(test_concurrentStack),
+        cmocka_unit_test(test_concurrentStack_threads),
+        cmocka_unit_test(test_concurrentQueue),
+        cmocka_unit_test(test_concurrentQueue_threads),
+        cmocka_unit_test(test_intrusiveList)
     };
 
     /* run tests and return number failed */
@@ -0,0 +1,278 @@
+/**
+ * @file    typedlist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Generator for type specialised linked lists. LL_DEFINE() emits a
+ *          list that stores values of one type directly in its nodes, with a
+ *          comparison known at compile time so it can be inlined into sorting
+ *          and searching.
+ */
+
+
+#ifndef TYPEDLIST_H
+#define TYPEDLIST_H
+
+
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The storage class of the generated functions. They are `static`, and marked
+ * inline where the compiler allows it, so unused functions cost nothing.
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+    #define LL_INLINE static inline
+#elif defined(__GNUC__)
+    #define LL_INLINE static __inline__
+#else
+    #define LL_INLINE static
+#endif
+
+
+/***** TRAVERSAL MACROS *****/
+
+/**
+ * @brief Iterate over the nodes of a typed list in order.
+ *
+ * The body can read or modify `node->value` directly, so no call is made per
+ * element. The current node must not be removed within the loop body.
+ *
+ * @param name The name the list was defined with.
+ * @param node A `name##Node *` variable set to each node in turn.
+ * @param list A pointer to the list to iterate over.
+ */
+#define LL_FOR_EACH(name, node, list) \
+    for ((node) = (list)->head; (node); (node) = (node)->next)
+
+
+/***** GENERATOR *****/
+
+/**
+ * @brief Define a linked list of values of a single type.
+ *
+ * Defines the types `name` and `name##Node`, and the functions below, each
+ * prefixed with `name`:
+ *
+ * - `void Init(name *list)` prepares an empty list, which may be on the stack.
+ * - `void Clear(name *list)` frees every node, leaving the list empty.
+ * - `int InsertTop(name *list, type value)` and `InsertTail()` copy @p value
+ *   into a new node, returning zero if memory could not be allocated.
+ * - `int InsertSorted(name *list, type value)` inserts in sorted order, after
+ *   any equal values.
+ * - `int RemoveTop(name *list, type *value)` removes the first value, copying
+ *   it out if @p value is not `NULL`. Returns zero if the list was empty.
+ * - `type *PeekTop(name *list)` and `PeekTail()` return the first and last
+ *   values, or `NULL` if empty.
+ * - `type *Find(name *list, type needle)` returns the first value equal to
+ *   @p needle, or `NULL` if there is none.
+ * - `void Sort(name *list)` sorts the list in O(n log n) time, keeping equal
+ *   values in order.
+ * - `void *Reduce(name *list, void *(*callback)(type *, void *), void *seed)`
+ *   behaves the same as reduceList().
+ * - `unsigned long Length(name *list)` returns the number of values.
+ *
+ * For example, `LL_DEFINE(IntList, int, INT_CMP)` defines `IntList`,
+ * `IntListInsertTop()` and so on.
+ *
+ * @param name The name of the list type, used as the prefix of every function.
+ * @param type The type of each value. It is copied by assignment.
+ * @param cmp A function or function-like macro taking two values of @p type
+ *            and returning an integer less than, equal to or greater than zero,
+ *            as for a `DifferenceFunc`.
+ */
+#define LL_DEFINE(name, type, cmp) \
+ \
+typedef struct name##Node { \
+    struct name##Node *next; \
+    type value; \
+} name##Node; \
+ \
+typedef struct name { \
+    name##Node *head; \
+    name##Node *tail; \
+    unsigned long length; \
+} name; \
+ \
+LL_INLINE void name##Init(name *list) \
+{ \
+    list->head = NULL; \
+    list->tail = NULL; \
+    list->length = 0; \
+} \
+ \
+LL_INLINE void name##Clear(name *list) \
+{ \
+    while (list->head) \
+    { \
+        name##Node *top = list->head; \
+        list->head = top->next; \
+        free(top); \
+    } \
+    name##Init(list); \
+} \
+ \
+LL_INLINE name##Node *name##NewNode(type value) \
+{ \
+    name##Node *node = (name##Node *) malloc(sizeof(name##Node)); \
+    if (node) \
+    { \
+        node->next = NULL; \
+        node->value = value; \
+    } \
+    return node; \
+} \
+ \
+LL_INLINE int name##InsertTop(name *list, type value) \
+{ \
+    name##Node *node = name##NewNode(value); \
+    if (!node) \
+        return FALSE; \
+    node->next = list->head; \
+    list->head = node; \
+    if (!list->tail) \
+        list->tail = node; \
+    list->length++; \
+    return TRUE; \
+} \
+ \
+LL_INLINE int name##InsertTail(name *list, type value) \
+{ \
+    name##Node *node = name##NewNode(value); \
+    if (!node) \
+        return FALSE; \
+    if (list->tail) \
+        list->tail->next = node; \
+    else \
+        list->head = node; \
+    list->tail = node; \
+    list->length++; \
+    return TRUE; \
+} \
+ \
+LL_INLINE int name##InsertSorted(name *list, type value) \
+{ \
+    name##Node **link = &list->head; \
+    name##Node *node; \
+    /* values that belong at the end need no search */ \
+    if (list->tail && cmp(list->tail->value, value) <= 0) \
+        return name##InsertTail(list, value); \
+    node = name##NewNode(value); \
+    if (!node) \
+        return FALSE; \
+    while (*link && cmp((*link)->value, value) <= 0) \
+        link = &(*link)->next; \
+    node->next = *link; \
+    *link = node; \
+    if (!node->next) \
+        list->tail = node; \
+    list->length++; \
+    return TRUE; \
+} \
+ \
+LL_INLINE int name##RemoveTop(name *list, type *value) \
+{ \
+    name##Node *top = list->head; \
+    if (!top) \
+        return FALSE; \
+    if (value) \
+        *value = top->value; \
+    list->head = top->next; \
+    if (!list->head) \
+        list->tail = NULL; \
+    list->length--; \
+    free(top); \
+    return TRUE; \
+} \
+ \
+LL_INLINE type *name##PeekTop(name *list) \
+{ \
+    return list->head ? &list->head->value : NULL; \
+} \
+ \
+LL_INLINE type *name##PeekTail(name *list) \
+{ \
+    return list->tail ? &list->tail->value : NULL; \
+} \
+ \
+LL_INLINE type *name##Find(name *list, type needle) \
+{ \
+    name##Node *node; \
+    LL_FOR_EACH(name, node, list) \
+    { \
+        if (cmp(node->value, needle) == 0) \
+            return &node->value; \
+    } \
+    return NULL; \
+} \
+ \
+LL_INLINE name##Node *name##MergeChains(name##Node *left, name##Node *right) \
+{ \
+    name##Node *head = NULL; \
+    name##Node **link = &head; \
+    while (left && right) \
+    { \
+        if (cmp(left->value, right->value) <= 0) \
+        { \
+            *link = left; \
+            left = left->next; \
+        } \
+        else \
+        { \
+            *link = right; \
+            right = right->next; \
+        } \
+        link = &(*link)->next; \
+    } \
+    *link = left ? left : right; \
+    return head; \
+} \
+ \
+LL_INLINE void name##Sort(name *list) \
+{ \
+    /* bins[i] holds a sorted run of 2^i nodes, as for sortList() */ \
+    name##Node *bins[sizeof(unsigned long) * 8]; \
+    name##Node *run; \
+    unsigned long filled = 0; \
+    unsigned long i; \
+    while (list->head) \
+    { \
+        run = list->head; \
+        list->head = run->next; \
+        run->next = NULL; \
+        for (i = 0; i < filled && bins[i]; i++) \
+        { \
+            run = name##MergeChains(bins[i], run); \
+            bins[i] = NULL; \
+        } \
+        if (i == filled) \
+            filled++; \
+        bins[i] = run; \
+    } \
+    run = NULL; \
+    for (i = 0; i < filled; i++) \
+    { \
+        if (bins[i]) \
+            run = name##MergeChains(bins[i], run); \
+    } \
+    list->head = run; \
+    for (list->tail = run; run; run = run->next) \
+        list->tail = run; \
+} \
+ \
+LL_INLINE void *name##Reduce(name *list, void *(*callback)(type *, void *), void *seed) \
+{ \
+    name##Node *node; \
+    LL_FOR_EACH(name, node, list) \
+        seed = callback(&node->value, seed); \
+    return seed; \
+} \
+ \
+LL_INLINE unsigned long name##Length(name *list) \
+{ \
+    return list->length; \
+}
+
+
+#endif /* end of include guard: TYPEDLIST_H */
@@ -0,0 +1,248 @@
+/**
+ * @file    unrolledlist.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Unrolled linked list source file. Only the ends of the list are
+ *          modified, so a full node is never split; a new node is started
+ *          instead, keeping nodes as full as possible.
+ */
+
+#include <string.h>
+#include "unrolledlist.h"
+
+
+/**
+ * Allocate an empty node and link it into @p list after @p previous, or at the
+ * head if @p previous is `NULL`.
+ */
+static UnrolledNode *addNode(UnrolledList *list, UnrolledNode *previous)
+{
+    UnrolledNode *node = (UnrolledNode *) malloc(sizeof(UnrolledNode));
+    if (!node)
+        return NULL;
+
+    node->count = 0;
+    node->prev = previous;
+    node->next = previous ? previous->next : list->head;
+
+    if (previous)
+        previous->next = node;
+    else
+        list->head = node;
+
+    if (node->next)
+        node->next->prev = node;
+    else
+        list->tail = node;
+
+    return node;
+}
+
+
+/**
+ * Unlink @p node from @p list and free it. The elements are not freed.
+ */
+static void deleteNode(UnrolledList *list, UnrolledNode *node)
+{
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+
+    free(node);
+}
+
+
+/**
+ * Move the elements of the node after @p node into @p node if there is room,
+ * and delete the emptied node.
+ */
+static void mergeNext(UnrolledList *list, UnrolledNode *node)
+{
+    UnrolledNode *next = node->next;
+
+    if (next && node->count + next->count <= UNROLLED_CAPACITY)
+    {
+        memcpy(node->data + node->count, next->data,
+                next->count * sizeof(DataPointer));
+        node->count += next->count;
+        deleteNode(list, next);
+    }
+}
+
+
+UnrolledList* createUnrolledList()
+{
+    /* allocate memory for the list */
+    UnrolledList *list = (UnrolledList *) malloc(sizeof(UnrolledList));
+
+    /* if no error in allocating, initialise list contents */
+    if (list)
+    {
+        list->head = NULL;
+        list->tail = NULL;
+        list->length = 0;
+    }
+
+    return list;
+}
+
+
+void *reduceUnrolledList(UnrolledList *list, Reducer callback, void *seed)
+{
+    UnrolledNode *node;
+    unsigned int i;
+
+    if (!list)
+        return seed;
+
+    /* iterate over each element of each node */
+    for (node = list->head; node; node = node->next)
+        for (i = 0; i < node->count; i++)
+            seed = callback(node->data[i], seed);
+
+    return seed;
+}
+
+
+int insertUnrolledTop(UnrolledList *list, DataPointer data)
+{
+    UnrolledNode *top;
+
+    /* if list is NULL return immediately */
+    if (!list)
+        return FALSE;
+
+    /* start a new node if the first is full */
+    top = list->head;
+    if (!top || top->count == UNROLLED_CAPACITY)
+        top = addNode(list, NULL);
+    if (!top)
+        return FALSE;
+
+    /* shift the node's elements along to make room at the front */
+    memmove(top->data + 1, top->data, top->count * sizeof(DataPointer));
+    top->data[0] = data;
+    top->count++;
+    list->length++;
+
+    return TRUE;
+}
+
+
+int insertUnrolledTail(UnrolledList *list, DataPointer data)
+{
+    UnrolledNode *tail;
+
+    /* if list is NULL return immediately */
+    if (!list)
+        return FALSE;
+
+    /* start a new node if the last is full */
+    tail = list->tail;
+    if (!tail || tail->count == UNROLLED_CAPACITY)
+        tail = addNode(list, list->tail);
+    if (!tail)
+        return FALSE;
+
+    tail->data[tail->count++] = data;
+    list->length++;
+
+    return TRUE;
+}
+
+
+void destroyUnrolledList(UnrolledList *list)
+{
+    unsigned int i;
+
+    /* if list is not NULL */
+    if (list)
+    {
+        /* free each element then the node holding them */
+        while (list->head)
+        {
+            UnrolledNode *top = list->head;
+            for (i = 0; i < top->count; i++)
+                free(top->data[i]);
+            deleteNode(list, top);
+        }
+
+        /* free list struct */
+        free(list);
+    }
+}
+
+
+void removeUnrolledTop(UnrolledList *list)
+{
+    UnrolledNode *top;
+
+    /* if list is not NULL or empty */
+    if (list && list->head)
+    {
+        top = list->head;
+        free(top->data[0]);
+
+        top->count--;
+        list->length--;
+        memmove(top->data, top->data + 1, top->count * sizeof(DataPointer));
+
+        /* drop the node once empty, or merge it when it gets sparse */
+        if (!top->count)
+            deleteNode(list, top);
+        else if (top->count < UNROLLED_CAPACITY / 2)
+            mergeNext(list, top);
+    }
+}
+
+
+void removeUnrolledTail(UnrolledList *list)
+{
+    UnrolledNode *tail;
+
+    /* if list is not NULL or empty */
+    if (list && list->tail)
+    {
+        tail = list->tail;
+        free(tail->data[--tail->count]);
+        list->length--;
+
+        /* drop the node once empty, or merge it when it gets sparse */
+        if (!tail->count)
+            deleteNode(list, tail);
+        else if (tail->count < UNROLLED_CAPACITY / 2 && tail->prev)
+            mergeNext(list, tail->prev);
+    }
+}
+
+
+unsigned long unrolledListLength(UnrolledList *list)
+{
+    return list ? list->length : 0;
+}
+
+
+DataPointer peekUnrolledTop(UnrolledList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->head)
+        return list->head->data[0];
+
+    return NULL;
+}
+
+
+DataPointer peekUnrolledTail(UnrolledList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->tail)
+        return list->tail->data[list->tail->count - 1];
+
+    return NULL;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file    unrolledlist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   Unrolled linked list. Each node stores a block of elements so
+ *          traversals follow one pointer per block instead of one per element.
+ */
+
+
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+
+#include "linkedlist.h"
+
+
+/***** CONDITIONAL COMPILATION *****/
+
+/**
+ * The size in bytes of a single node in an unrolled list. This defaults to one
+ * cache line and determines how many elements each node can hold.
+ */
+#ifndef UNROLLED_NODE_SIZE
+    #define UNROLLED_NODE_SIZE 64
+#endif
+
+/**
+ * The number of elements that fit within a single node.
+ */
+#define UNROLLED_CAPACITY ((UNROLLED_NODE_SIZE - 2 * sizeof(void *) - \
+            sizeof(unsigned int)) / sizeof(DataPointer))
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` representing a node within an unrolled list. The first `count`
+ * entries of `data` are in use.
+ */
+typedef struct UnrolledNode {
+    struct UnrolledNode *next;
+    struct UnrolledNode *prev;
+    unsigned int count;
+    DataPointer data[UNROLLED_CAPACITY];
+} UnrolledNode;
+
+
+/**
+ * A `struct` representing an unrolled list.
+ */
+typedef struct UnrolledList {
+    UnrolledNode *head;
+    UnrolledNode *tail;
+    unsigned long length;
+} UnrolledList;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Create a new empty unrolled list.
+ *
+ * @return A pointer to a new empty unrolled list or `NULL` on error.
+ */
+UnrolledList* createUnrolledList();
+
+
+/**
+ * @brief Perform a reduce operation on an unrolled list.
+ *
+ * Behaves the same as reduceList(), calling @p callback on each element in
+ * order.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each element in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceUnrolledList(UnrolledList *list, Reducer callback, void *seed);
+
+
+/**
+ * @brief Insert an element at the top of an unrolled list.
+ *
+ * The element is added to the first node if it has space, otherwise a new
+ * node is started in front of it.
+ *
+ * @param list The list to add to.
+ * @param data The data to insert into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertUnrolledTop(UnrolledList *list, DataPointer data);
+
+
+/**
+ * @brief Insert an element at the end of an unrolled list.
+ *
+ * The element is added to the last node if it has space, otherwise a new node
+ * is started after it.
+ *
+ * @param list The list to add to.
+ * @param data The data to insert into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertUnrolledTail(UnrolledList *list, DataPointer data);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete an entire unrolled list.
+ *
+ * Frees all the memory associated with @p list, including each element.
+ *
+ * @param list The list to delete.
+ */
+void destroyUnrolledList(UnrolledList *list);
+
+
+/**
+ * @brief Delete the element at the top of an unrolled list.
+ *
+ * If it exists, the first element is removed and `free()` is called on it.
+ * When the first node becomes less than half full it is merged into the next
+ * node if they fit together.
+ *
+ * @param list The list to remove from.
+ */
+void removeUnrolledTop(UnrolledList *list);
+
+
+/**
+ * @brief Delete the element at the end of an unrolled list.
+ *
+ * If it exists, the last element is removed and `free()` is called on it.
+ * When the last node becomes less than half full it is merged into the
+ * previous node if they fit together.
+ *
+ * @param list The list to remove from.
+ */
+void removeUnrolledTail(UnrolledList *list);
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+/**
+ * @brief Get the number of elements in an unrolled list.
+ *
+ * @param list The list to determine the length of.
+ * @return The size of the supplied list.
+ */
+unsigned long unrolledListLength(UnrolledList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the first element of an unrolled
+ *        list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the first element, or `NULL` if empty.
+ */
+DataPointer peekUnrolledTop(UnrolledList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the last element of an unrolled list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the last element, or `NULL` if empty.
+ */
+DataPointer peekUnrolledTail(UnrolledList *list);
+
+
+#endif /* end of include guard: UNROLLEDLIST_H */
@@ -0,0 +1,196 @@
+/**
+ * @file    xorlist.c
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   XOR linked list source file. The list is symmetric, so each
+ *          operation on the top is the same as the one on the end with the
+ *          roles of `head` and `tail` swapped.
+ */
+
+#include "xorlist.h"
+
+
+/**
+ * Get the neighbour of @p node on the other side from @p from, which may be
+ * `NULL` at either end of the list.
+ */
+static XorNode *stepNode(XorNode *from, XorNode *node)
+{
+    return (XorNode *) (node->link ^ (uintptr_t) from);
+}
+
+
+/**
+ * Add a node holding @p data before @p *end, the first node in the direction
+ * being inserted into. @p other is the opposite end of the list.
+ */
+static int insertEnd(XorList *list, XorNode **end, XorNode **other,
+        DataPointer data)
+{
+    XorNode *node = (XorNode *) malloc(sizeof(XorNode));
+    if (!node)
+        return FALSE;
+
+    node->data = data;
+    node->link = (uintptr_t) *end;
+
+    /* the old end node gains a neighbour where it had none */
+    if (*end)
+        (*end)->link ^= (uintptr_t) node;
+    else
+        *other = node;
+
+    *end = node;
+    list->length++;
+
+    return TRUE;
+}
+
+
+/**
+ * Remove the node at @p *end and free its data. @p other is the opposite end
+ * of the list.
+ */
+static void removeEnd(XorList *list, XorNode **end, XorNode **other)
+{
+    XorNode *node = *end;
+    XorNode *next = stepNode(NULL, node);
+
+    /* the new end node loses its neighbour on this side */
+    if (next)
+        next->link ^= (uintptr_t) node;
+    else
+        *other = NULL;
+
+    *end = next;
+    list->length--;
+
+    free(node->data);
+    free(node);
+}
+
+
+/**
+ * Call @p callback on each element, starting from @p node at one end.
+ */
+static void *reduceFrom(XorNode *node, Reducer callback, void *seed)
+{
+    XorNode *previous = NULL;
+
+    while (node)
+    {
+        XorNode *next = stepNode(previous, node);
+
+        seed = callback(node->data, seed);
+        previous = node;
+        node = next;
+    }
+
+    return seed;
+}
+
+
+XorList* createXorList()
+{
+    /* allocate memory for the list */
+    XorList *list = (XorList *) malloc(sizeof(XorList));
+
+    /* if no error in allocating, initialise list contents */
+    if (list)
+    {
+        list->head = NULL;
+        list->tail = NULL;
+        list->length = 0;
+    }
+
+    return list;
+}
+
+
+void *reduceXorList(XorList *list, Reducer callback, void *seed)
+{
+    return list ? reduceFrom(list->head, callback, seed) : seed;
+}
+
+
+void *reduceXorListReverse(XorList *list, Reducer callback, void *seed)
+{
+    return list ? reduceFrom(list->tail, callback, seed) : seed;
+}
+
+
+int insertXorTop(XorList *list, DataPointer data)
+{
+    /* if list is NULL return immediately */
+    if (!list)
+        return FALSE;
+
+    return insertEnd(list, &list->head, &list->tail, data);
+}
+
+
+int insertXorTail(XorList *list, DataPointer data)
+{
+    /* if list is NULL return immediately */
+    if (!list)
+        return FALSE;
+
+    return insertEnd(list, &list->tail, &list->head, data);
+}
+
+
+void destroyXorList(XorList *list)
+{
+    /* if list is not NULL */
+    if (list)
+    {
+        /* free each element and its node */
+        while (list->head)
+            removeEnd(list, &list->head, &list->tail);
+
+        /* free list struct */
+        free(list);
+    }
+}
+
+
+void removeXorTop(XorList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->head)
+        removeEnd(list, &list->head, &list->tail);
+}
+
+
+void removeXorTail(XorList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->tail)
+        removeEnd(list, &list->tail, &list->head);
+}
+
+
+unsigned long xorListLength(XorList *list)
+{
+    return list ? list->length : 0;
+}
+
+
+DataPointer peekXorTop(XorList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->head)
+        return list->head->data;
+
+    return NULL;
+}
+
+
+DataPointer peekXorTail(XorList *list)
+{
+    /* if list is not NULL or empty */
+    if (list && list->tail)
+        return list->tail->data;
+
+    return NULL;
+}
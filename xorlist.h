@@ -0,0 +1,162 @@
+/**
+ * @file    xorlist.h
+ * @author  Jarryd Tilbrook
+ * @date    24 May 2016
+ * @brief   XOR linked list. Each node stores its previous and next addresses
+ *          combined into one field, so the list can be traversed in both
+ *          directions at the memory cost of a singly linked list.
+ */
+
+
+#ifndef XORLIST_H
+#define XORLIST_H
+
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+
+/***** DATATYPE DEFINITIONS *****/
+
+/**
+ * A `struct` representing a node within an XOR list. `link` holds the
+ * addresses of the previous and next nodes XORed together, where a missing
+ * node counts as zero. A neighbour can only be found from the other one.
+ */
+typedef struct XorNode {
+    uintptr_t link;
+    DataPointer data;
+} XorNode;
+
+
+/**
+ * A `struct` representing an XOR list. Traversals start from either end.
+ */
+typedef struct XorList {
+    XorNode *head;
+    XorNode *tail;
+    unsigned long length;
+} XorList;
+
+
+/***** INSERTION & MODIFICATION FUNCTIONS *****/
+
+/**
+ * @brief Create a new empty XOR list.
+ *
+ * @return A pointer to a new empty XOR list or `NULL` on error.
+ */
+XorList* createXorList();
+
+
+/**
+ * @brief Perform a reduce operation on an XOR list.
+ *
+ * Behaves the same as reduceList(), calling @p callback on each element from
+ * the top of the list to the end.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each element in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceXorList(XorList *list, Reducer callback, void *seed);
+
+
+/**
+ * @brief Perform a reduce operation on an XOR list in reverse.
+ *
+ * As for reduceXorList(), but the elements are visited from the end of the list
+ * to the top.
+ *
+ * @param list A list to reduce to a single value.
+ * @param callback A function called for each element in the list.
+ * @param seed An initial value to pass to the callback for the first invocation.
+ * @return A pointer to the result of reducing the list.
+ */
+void *reduceXorListReverse(XorList *list, Reducer callback, void *seed);
+
+
+/**
+ * @brief Insert an element at the top of an XOR list.
+ *
+ * @param list The list to add to.
+ * @param data The data to insert into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertXorTop(XorList *list, DataPointer data);
+
+
+/**
+ * @brief Insert an element at the end of an XOR list.
+ *
+ * @param list The list to add to.
+ * @param data The data to insert into the list.
+ * @return Positive integer for successful insertion, zero otherwise.
+ */
+int insertXorTail(XorList *list, DataPointer data);
+
+
+/***** REMOVAL & DELETION FUNCTIONS *****/
+
+/**
+ * @brief Delete an entire XOR list.
+ *
+ * Frees all the memory associated with @p list, including each element.
+ *
+ * @param list The list to delete.
+ */
+void destroyXorList(XorList *list);
+
+
+/**
+ * @brief Delete the element at the top of an XOR list.
+ *
+ * If it exists, the first element is removed and `free()` is called on it.
+ *
+ * @param list The list to remove from.
+ */
+void removeXorTop(XorList *list);
+
+
+/**
+ * @brief Delete the element at the end of an XOR list.
+ *
+ * If it exists, the last element is removed and `free()` is called on it. This
+ * takes constant time.
+ *
+ * @param list The list to remove from.
+ */
+void removeXorTail(XorList *list);
+
+
+/***** FINDING & SEARCHING FUNCTIONS *****/
+
+/**
+ * @brief Get the number of elements in an XOR list.
+ *
+ * @param list The list to determine the length of.
+ * @return The size of the supplied list.
+ */
+unsigned long xorListLength(XorList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the first element of an XOR list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the first element, or `NULL` if empty.
+ */
+DataPointer peekXorTop(XorList *list);
+
+
+/**
+ * @brief Retrieves, but does not remove, the last element of an XOR list.
+ *
+ * @param list The list to retrieve from.
+ * @return A pointer to the last element, or `NULL` if empty.
+ */
+DataPointer peekXorTail(XorList *list);
+
+
+#endif /* end of include guard: XORLIST_H */